@@ -0,0 +1,149 @@
+
+/**
+ * @brief - Measure the time needed to generate mazes with each
+ *          strategy and each kind of cells. The results can be
+ *          compared between two versions to catch regressions.
+ *          Usage: bench [size] [runs] where `size` is the side of
+ *          the generated mazes in cells (1000 by default) and the
+ *          `runs` is the number of generations timed for each of
+ *          them (5 by default). The median time is reported.
+ */
+
+# include <chrono>
+# include <cstdio>
+# include <string>
+# include <vector>
+# include <cstdlib>
+# include <algorithm>
+# include <functional>
+# include "Maze.hh"
+# include "Workspace.hh"
+
+namespace {
+
+  /// @brief - The strategies measured by the benchmark.
+  const std::vector<maze::Strategy> STRATEGIES = {
+    maze::Strategy::RandomizedKruskal,
+    maze::Strategy::RandomizedPrim,
+    maze::Strategy::DepthFirst,
+    maze::Strategy::Wilson,
+    maze::Strategy::AldousBroder,
+    maze::Strategy::Eller,
+    maze::Strategy::BinaryTree,
+    maze::Strategy::Sidewinder,
+    maze::Strategy::ParallelKruskal,
+    maze::Strategy::Boruvka,
+    maze::Strategy::RecursiveDivision,
+    maze::Strategy::GrowingTree
+  };
+
+  /**
+   * @brief - Time the input process and return the median of the
+   *          durations of the runs. A first run is performed and
+   *          not timed so that lazily built data is ready.
+   * @param runs - the number of timed runs.
+   * @param process - the process to time, receiving the index
+   *                  of the run.
+   * @return - the median duration in milliseconds.
+   */
+  double
+  median(unsigned runs, const std::function<void(unsigned)>& process) {
+    using Clock = std::chrono::steady_clock;
+
+    process(0u);
+
+    std::vector<double> times;
+    for (unsigned id = 1u ; id <= runs ; ++id) {
+      Clock::time_point start = Clock::now();
+      process(id);
+      times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2u];
+  }
+
+  /**
+   * @brief - Print the result of a measure.
+   * @param name - the name of the measure.
+   * @param ms - the median duration in milliseconds.
+   * @param cells - the number of cells of the maze.
+   */
+  void
+  report(const std::string& name, double ms, unsigned cells) {
+    std::printf("  %-32s %10.1f ms %8.1f ns/cell\n", name.c_str(), ms, ms * 1.0e6 / cells);
+  }
+
+}
+
+int
+main(int argc, char** argv) {
+  unsigned size = (argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 1000u);
+  unsigned runs = (argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 5u);
+  runs = std::max(runs, 1u);
+
+  maze::ThreadPool pool;
+  maze::Workspace workspace;
+  unsigned cells = size * size;
+
+  std::printf("Generating %ux%u mazes, median of %u run(s)\n", size, size, runs);
+
+  for (unsigned sides : {3u, 4u, 6u}) {
+    std::printf("%s\n", (sides == 3u ? "triangle" : sides == 4u ? "square" : "hexagon"));
+
+    for (const maze::Strategy& st : STRATEGIES) {
+      // Some strategies only support square cells.
+      bool squareOnly = (st == maze::Strategy::BinaryTree || st == maze::Strategy::Sidewinder);
+      if (squareOnly && sides != 4u) {
+        continue;
+      }
+
+      maze::MazeShPtr m = maze::Maze::create(size, size, st, sides);
+      std::string name = maze::strategyToString(st);
+
+      try {
+        // The parallel strategies use the threads of the pool, the
+        // other ones reuse the same workspace as in the game.
+        double ms = median(runs,
+          [&m, &pool, &workspace, st](unsigned id) {
+            if (maze::strategyIsParallel(st)) {
+              m->generate(id, pool);
+            }
+            else {
+              m->generation(id, nullptr, &workspace)->run();
+            }
+          }
+        );
+
+        report(name, ms, cells);
+
+        // The sequential strategies can also be split in tiles.
+        if (!maze::strategyIsParallel(st)) {
+          ms = median(runs,
+            [&m, &pool](unsigned id) {
+              m->generate(id, pool);
+            }
+          );
+
+          report(name + " (tiles)", ms, cells);
+        }
+      }
+      catch (const std::exception& e) {
+        std::printf("  %-32s %s\n", name.c_str(), e.what());
+      }
+    }
+
+    // Braid a maze generated with the default strategy.
+    maze::MazeShPtr m = maze::Maze::create(size, size, maze::Strategy::RandomizedKruskal, sides);
+    double ms = median(runs,
+      [&m, &pool](unsigned id) {
+        m->generate(id);
+        m->braid(id, 1.0f, pool);
+      }
+    );
+
+    report("Kruskal + braid", ms, cells);
+  }
+
+  return EXIT_SUCCESS;
+}
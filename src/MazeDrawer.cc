@@ -807,7 +807,7 @@ namespace maze {
       return;
     }
 
-    const maze::Cell& c = m_maze.at(x, y);
+    maze::Cell c = m_maze.at(x, y);
     for (unsigned id = 0u ; id < c.doors() ; ++id) {
       if (!c(id)) {
         drawDoor(x, y, id);
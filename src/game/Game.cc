@@ -1,5 +1,6 @@
 
 # include "Game.hh"
+# include <chrono>
 # include <cxxabi.h>
 # include <core_utils/Chrono.hh>
 # include "Menu.hh"
@@ -13,6 +14,15 @@
 /// @brief - The height of the sides menu in pixels.
 # define SIDES_MENU_HEIGHT 50
 
+/// @brief - The step between two fractions of dead ends removed
+/// from the maze.
+# define BRAID_STEP 0.25f
+
+/// @brief - The time in milliseconds spent each frame to advance
+/// the generation of the maze when it is not performed in the
+/// background.
+# define GENERATION_FRAME_BUDGET_MS 8
+
 namespace {
 
   pge::MenuShPtr
@@ -61,13 +71,45 @@ namespace pge {
     m_width(50u),
     m_height(50u),
     m_strategy(maze::Strategy::RandomizedKruskal),
+    m_policy(maze::growingtree::DEFAULT_POLICY),
+    m_braid(0.0f),
+    m_background(true),
+    m_tiled(false),
     m_sides(4u),
-    m_maze(std::make_shared<maze::SquareMaze>(m_width, m_height, m_strategy))
+
+    m_seeds(maze::Random::entropy()),
+    m_seed(0u),
+    m_seeded(false),
+
+    m_pool(),
+
+    m_maze(std::make_shared<maze::SquareMaze>(m_width, m_height, m_strategy)),
+    m_spares(),
+    m_generation(),
+
+    m_worker(),
+    m_context(),
+    m_workspace(),
+    m_finished(false),
+    m_pending(),
+    m_failure(),
+
+    m_abandoned(false),
+    m_deferred(false),
+    m_deferredSeed(0u)
   {
     setService("game");
   }
 
-  Game::~Game() {}
+  Game::~Game() {
+    // The worker uses the attributes of the game: wait for it
+    // to notice the cancellation.
+    cancelGeneration();
+
+    if (m_worker.joinable()) {
+      m_worker.join();
+    }
+  }
 
   const maze::Maze&
   Game::maze() const noexcept {
@@ -88,6 +130,25 @@ namespace pge {
     m_menus.strategy = generateMenu(pos, dims, "Strategy: " + maze::strategyToString(m_strategy), "strat");
     str = (m_sides == 3u ? "triangle" : m_sides == 4u ? "square" : "hexagon");
     m_menus.sides = generateMenu(pos, dims, "Cell kind: " + str, "sides");
+    m_menus.seed = generateMenu(pos, dims, "Seed: -", "seed");
+    m_menus.braid = generateMenu(pos, dims, "Braid: 0%", "braid", true);
+    m_menus.braid->setSimpleAction(
+      [this](Game& g) {
+        g.nextBraidFraction();
+      }
+    );
+    m_menus.mode = generateMenu(pos, dims, "Mode: background", "mode", true);
+    m_menus.mode->setSimpleAction(
+      [this](Game& g) {
+        g.toggleBackgroundGeneration();
+      }
+    );
+    m_menus.tiles = generateMenu(pos, dims, "Tiles: off", "tiles", true);
+    m_menus.tiles->setSimpleAction(
+      [this](Game& g) {
+        g.toggleTiledGeneration();
+      }
+    );
     MenuShPtr gen = generateMenu(pos, dims, "Generate !", "generate", true);
     gen->setSimpleAction(
       [this](Game& g) {
@@ -99,6 +160,10 @@ namespace pge {
     status->addMenu(m_menus.dims);
     status->addMenu(m_menus.strategy);
     status->addMenu(m_menus.sides);
+    status->addMenu(m_menus.seed);
+    status->addMenu(m_menus.braid);
+    status->addMenu(m_menus.mode);
+    status->addMenu(m_menus.tiles);
     status->addMenu(gen);
 
     // Generate the menu for the generation properties.
@@ -132,12 +197,30 @@ namespace pge {
 
     MenuShPtr kruskal = generateMenu(pos, dims, "Kruskal", "kruskal", true, true);
     MenuShPtr prim = generateMenu(pos, dims, "Prim", "prim", true, true);
-    MenuShPtr aldousBroder = generateMenu(pos, dims, "Depth-first", "depthfirst", true, true);
+    MenuShPtr depthFirst = generateMenu(pos, dims, "Depth-first", "depthfirst", true, true);
+    MenuShPtr wilson = generateMenu(pos, dims, "Wilson", "wilson", true, true);
+    MenuShPtr aldousBroder = generateMenu(pos, dims, "Aldous-Broder", "aldousbroder", true, true);
+    MenuShPtr eller = generateMenu(pos, dims, "Eller", "eller", true, true);
+    MenuShPtr binaryTree = generateMenu(pos, dims, "Binary tree", "binarytree", true, true);
+    MenuShPtr sidewinder = generateMenu(pos, dims, "Sidewinder", "sidewinder", true, true);
+    MenuShPtr parallelKruskal = generateMenu(pos, dims, "Parallel Kruskal", "parallelkruskal", true, true);
+    MenuShPtr boruvka = generateMenu(pos, dims, "Boruvka", "boruvka", true, true);
+    MenuShPtr division = generateMenu(pos, dims, "Recursive division", "division", true, true);
+    MenuShPtr growingTree = generateMenu(pos, dims, "Growing tree", "growingtree", true, true);
 
     // Register menus in the parent.
     props->addMenu(kruskal);
     props->addMenu(prim);
+    props->addMenu(depthFirst);
+    props->addMenu(wilson);
     props->addMenu(aldousBroder);
+    props->addMenu(eller);
+    props->addMenu(binaryTree);
+    props->addMenu(sidewinder);
+    props->addMenu(parallelKruskal);
+    props->addMenu(boruvka);
+    props->addMenu(division);
+    props->addMenu(growingTree);
     kruskal->setSimpleAction(
       [this](Game& g) {
         g.setGenerationStrategy(maze::Strategy::RandomizedKruskal);
@@ -148,11 +231,56 @@ namespace pge {
         g.setGenerationStrategy(maze::Strategy::RandomizedPrim);
       }
     );
-    aldousBroder->setSimpleAction(
+    depthFirst->setSimpleAction(
       [this](Game& g) {
         g.setGenerationStrategy(maze::Strategy::DepthFirst);
       }
     );
+    wilson->setSimpleAction(
+      [this](Game& g) {
+        g.setGenerationStrategy(maze::Strategy::Wilson);
+      }
+    );
+    aldousBroder->setSimpleAction(
+      [this](Game& g) {
+        g.setGenerationStrategy(maze::Strategy::AldousBroder);
+      }
+    );
+    eller->setSimpleAction(
+      [this](Game& g) {
+        g.setGenerationStrategy(maze::Strategy::Eller);
+      }
+    );
+    binaryTree->setSimpleAction(
+      [this](Game& g) {
+        g.setGenerationStrategy(maze::Strategy::BinaryTree);
+      }
+    );
+    sidewinder->setSimpleAction(
+      [this](Game& g) {
+        g.setGenerationStrategy(maze::Strategy::Sidewinder);
+      }
+    );
+    parallelKruskal->setSimpleAction(
+      [this](Game& g) {
+        g.setGenerationStrategy(maze::Strategy::ParallelKruskal);
+      }
+    );
+    boruvka->setSimpleAction(
+      [this](Game& g) {
+        g.setGenerationStrategy(maze::Strategy::Boruvka);
+      }
+    );
+    division->setSimpleAction(
+      [this](Game& g) {
+        g.setGenerationStrategy(maze::Strategy::RecursiveDivision);
+      }
+    );
+    growingTree->setSimpleAction(
+      [this](Game& g) {
+        g.selectGrowingTree();
+      }
+    );
 
     // Package menus for output.
     std::vector<MenuShPtr> menus;
@@ -179,6 +307,24 @@ namespace pge {
       return true;
     }
 
+    // Advance the generation of the displayed maze if any.
+    if (m_generation != nullptr) {
+      advanceGeneration();
+    }
+
+    // Publish the maze generated in the background if any, or
+    // discard it in case the generation was cancelled.
+    if (m_finished.load(std::memory_order_acquire)) {
+      publishMaze();
+    }
+
+    // Start the generation requested while the worker of the
+    // cancelled one was still running.
+    if (m_deferred && !m_worker.joinable()) {
+      m_deferred = false;
+      generateMaze(m_deferredSeed);
+    }
+
     updateUI();
 
     return true;
@@ -244,6 +390,38 @@ namespace pge {
     resetMaze();
   }
 
+  void
+  Game::selectGrowingTree() noexcept {
+    // Only available when the game is not paused.
+    if (m_state.paused) {
+      return;
+    }
+
+    if (m_strategy != maze::Strategy::GrowingTree) {
+      setGenerationStrategy(maze::Strategy::GrowingTree);
+      return;
+    }
+
+    // Cycle through the policies to pick the cell to expand.
+    switch (m_policy.selection) {
+      case maze::growingtree::Selection::Newest:
+        m_policy.selection = maze::growingtree::Selection::Random;
+        break;
+      case maze::growingtree::Selection::Random:
+        m_policy.selection = maze::growingtree::Selection::Oldest;
+        break;
+      case maze::growingtree::Selection::Oldest:
+        m_policy.selection = maze::growingtree::Selection::Mix;
+        break;
+      case maze::growingtree::Selection::Mix:
+      default:
+        m_policy.selection = maze::growingtree::Selection::Newest;
+        break;
+    }
+
+    info("Growing tree now uses policy " + maze::growingtree::policyToString(m_policy));
+  }
+
   void
   Game::setCellSidesCount(unsigned sides) noexcept {
     // Only available when the game is not paused.
@@ -260,6 +438,45 @@ namespace pge {
     resetMaze();
   }
 
+  void
+  Game::nextBraidFraction() noexcept {
+    // Only available when the game is not paused.
+    if (m_state.paused) {
+      return;
+    }
+
+    // Cycle through fractions of dead ends by steps of 25%.
+    m_braid += BRAID_STEP;
+    if (m_braid > 1.0f + BRAID_STEP / 2.0f) {
+      m_braid = 0.0f;
+    }
+  }
+
+  void
+  Game::toggleBackgroundGeneration() noexcept {
+    // Only available when the game is not paused.
+    if (m_state.paused) {
+      return;
+    }
+
+    // The generation in progress is interrupted as it runs in
+    // the other mode.
+    cancelGeneration();
+    m_background = !m_background;
+  }
+
+  void
+  Game::toggleTiledGeneration() noexcept {
+    // Only available when the game is not paused.
+    if (m_state.paused) {
+      return;
+    }
+
+    // The generation in progress is left as is: only the next
+    // ones are split in tiles.
+    m_tiled = !m_tiled;
+  }
+
   void
   Game::generateMaze() {
     // Only available when the game is not paused.
@@ -267,8 +484,50 @@ namespace pge {
       return;
     }
 
-    // Only available if a maze is defined.
-    if (m_maze == nullptr) {
+    generateMaze(m_seeds.next());
+  }
+
+  void
+  Game::generateMaze(std::uint64_t seed) {
+    // Only available when the game is not paused.
+    if (m_state.paused) {
+      return;
+    }
+
+    // Interrupt the previous generation if any.
+    cancelGeneration();
+
+    m_seed = seed;
+    m_seeded = false;
+
+    // The worker of a cancelled generation still uses the context,
+    // the workspace and the pool until it notices the request: the
+    // new generation is started once it is done (see `step`).
+    if (m_worker.joinable()) {
+      m_deferred = true;
+      m_deferredSeed = seed;
+
+      return;
+    }
+
+    // In the background, the maze is generated in a new instance
+    // so that the current one can still be displayed in the
+    // meantime. Otherwise the displayed maze is generated.
+    maze::MazeShPtr m;
+    if (m_background) {
+      m = createMaze();
+    }
+    else if (m_maze != nullptr && m_maze->sides() == m_sides) {
+      m_maze->reshape(m_width, m_height, m_strategy);
+      m = m_maze;
+    }
+    else {
+      recycleMaze(m_maze);
+      m_maze = createMaze();
+      m = m_maze;
+    }
+
+    if (m == nullptr) {
       warn("Failed to generate new maze", "No maze defined");
       return;
     }
@@ -277,13 +536,51 @@ namespace pge {
       "Generating maze with dimensions " +
       std::to_string(m_width) + "x" + std::to_string(m_height) +
       " and " + std::to_string(m_sides) + " side(s) with strategy " +
-      maze::strategyToString(m_strategy)
+      maze::strategyToString(m_strategy) + " and seed " + std::to_string(seed)
     );
 
-    {
-      utils::ChronoMilliseconds c("Maze generated", "maze");
-      m_maze->generate();
+    m->setPolicy(m_policy);
+
+    m_context.reset();
+
+    // When requested, the sequential strategies use the threads of
+    // the pool by splitting the maze in tiles: this gives another
+    // maze than the step-wise generation for the same seed, but it
+    // is still reproducible.
+    bool parallel = maze::strategyIsParallel(m_strategy) || m_tiled;
+
+    // The displayed maze is advanced at each frame.
+    if (!m_background) {
+      m_generation = startGeneration(*m, seed, parallel);
+      return;
     }
+
+    m_finished.store(false, std::memory_order_relaxed);
+    m_pending = m;
+
+    // The worker only accesses the new maze, the workspace and
+    // the pool of threads: the game waits for it before touching
+    // them.
+    float braid = m_braid;
+
+    m_worker = std::thread(
+      [this, m, seed, parallel, braid]() {
+        try {
+          std::unique_ptr<maze::Generation> g = startGeneration(*m, seed, parallel);
+          g->run();
+
+          // Create loops in the maze if needed.
+          if (braid > 0.0f && !m_context.cancelled()) {
+            m->braid(seed, braid, m_pool, &m_context);
+          }
+        }
+        catch (...) {
+          m_failure = std::current_exception();
+        }
+
+        m_finished.store(true, std::memory_order_release);
+      }
+    );
   }
 
   void
@@ -298,6 +595,8 @@ namespace pge {
 
     // In case the loading succeeded, reset the internal
     // attribute.
+    cancelGeneration();
+    recycleMaze(m_maze);
     m_maze = m;
 
     info(
@@ -306,6 +605,7 @@ namespace pge {
     );
 
     // Update internal properties.
+    m_seeded = false;
     m_width = m_maze->width();
     m_height = m_maze->height();
     m_sides = m_maze->sides();
@@ -354,29 +654,205 @@ namespace pge {
         break;
     }
 
-    m_menus.strategy->setText("Strategy: " + maze::strategyToString(m_strategy));
+    std::string strategy = maze::strategyToString(m_strategy);
+    if (m_strategy == maze::Strategy::GrowingTree) {
+      strategy += " (" + maze::growingtree::policyToString(m_policy) + ")";
+    }
+
+    m_menus.strategy->setText("Strategy: " + strategy);
 
     m_menus.sides->setText("Cell kind: " + text);
+
+    // Update the fraction of dead ends removed.
+    m_menus.braid->setText("Braid: " + std::to_string(static_cast<int>(m_braid * 100.0f + 0.5f)) + "%");
+
+    // Update the generation mode.
+    m_menus.mode->setText(std::string("Mode: ") + (m_background ? "background" : "animated"));
+    m_menus.tiles->setText(std::string("Tiles: ") + (m_tiled ? "on" : "off"));
+
+    // Update the seed of the maze.
+    if (m_deferred) {
+      m_menus.seed->setText("Seed: " + std::to_string(m_seed) + " (waiting for the previous generation)");
+    }
+    else if ((m_worker.joinable() && !m_abandoned) || m_generation != nullptr) {
+      int percent = static_cast<int>(m_context.completion() * 100.0f);
+      m_menus.seed->setText(
+        "Seed: " + std::to_string(m_seed) + " (generating " + std::to_string(percent) + "%, " +
+        std::to_string(m_context.visited()) + " cell(s))"
+      );
+    }
+    else {
+      m_menus.seed->setText("Seed: " + (m_seeded ? std::to_string(m_seed) : std::string("-")));
+    }
   }
 
   void
-  Game::resetMaze() noexcept {
-    // Generate a new maze.
-    m_maze.reset();
+  Game::publishMaze() {
+    // The worker is done so this does not block.
+    m_worker.join();
+    m_finished.store(false, std::memory_order_relaxed);
+
+    std::exception_ptr failure = m_failure;
+    maze::MazeShPtr m = m_pending;
+
+    m_failure = nullptr;
+    m_pending.reset();
+
+    // The maze of a cancelled generation is discarded, whether it
+    // is complete or not.
+    if (m_abandoned) {
+      m_abandoned = false;
+      recycleMaze(m);
+
+      return;
+    }
+
+    if (failure != nullptr) {
+      recycleMaze(m);
+
+      try {
+        std::rethrow_exception(failure);
+      }
+      catch (const std::exception& e) {
+        error("Failed to generate new maze", e.what());
+      }
+      catch (...) {
+        error("Failed to generate new maze", "Unknown error");
+      }
+
+      return;
+    }
+
+    // Swap the new maze with the one displayed: the previous maze
+    // is kept to generate the next one.
+    m_maze.swap(m);
+    recycleMaze(m);
+    m_seeded = true;
+
+    info("Maze generated with seed " + std::to_string(m_seed));
+  }
+
+  void
+  Game::advanceGeneration() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    Clock::duration budget = std::chrono::milliseconds(GENERATION_FRAME_BUDGET_MS);
+
+    // Process chunks of the generation until the time allotted
+    // to this frame is spent.
+    bool done = m_generation->done();
+    while (!done && Clock::now() - start < budget) {
+      done = m_generation->step(maze::DEFAULT_STEP_BUDGET);
+    }
+
+    if (!done) {
+      return;
+    }
+
+    m_generation.reset();
+    info("Maze generated with seed " + std::to_string(m_seed));
+
+    // Create loops in the maze if needed.
+    if (m_braid > 0.0f) {
+      utils::ChronoMilliseconds c("Maze braided", "maze");
+      m_maze->braid(m_seed, m_braid, m_pool);
+    }
+
+    m_seeded = true;
+  }
+
+  std::unique_ptr<maze::Generation>
+  Game::startGeneration(maze::Maze& m, std::uint64_t seed, bool parallel) {
+    // Strategies using several threads check for cancellation
+    // between the chunks of work they hand out to the pool: the
+    // other ones check for it between steps.
+    std::unique_ptr<maze::Generation> g;
+    if (parallel) {
+      g = std::make_unique<maze::Batch>(m,
+        [this, seed](maze::Maze& mz, maze::Context* context) {
+          mz.generate(seed, m_pool, context);
+        }
+      );
+
+      g->setContext(&m_context);
+    }
+    else {
+      g = m.generation(seed, &m_context, &m_workspace);
+    }
+
+    return g;
+  }
+
+  void
+  Game::cancelGeneration() noexcept {
+    // The maze generated in place is left as is.
+    m_generation.reset();
+    m_deferred = false;
+
+    if (!m_worker.joinable() || m_abandoned) {
+      return;
+    }
+
+    // The worker stops at the next check of the request: it is
+    // not waited for so that the game stays responsive, `step`
+    // discards the maze it was generating once it is done.
+    m_context.cancel();
+    m_abandoned = true;
+  }
+
+  maze::MazeShPtr
+  Game::createMaze() {
+    // Reuse the memory of a spare maze if possible.
+    for (unsigned id = 0u ; id < m_spares.size() ; ++id) {
+      if (m_spares[id]->sides() == m_sides) {
+        maze::MazeShPtr m = m_spares[id];
+        m_spares.erase(m_spares.begin() + id);
+
+        m->reshape(m_width, m_height, m_strategy);
+
+        return m;
+      }
+    }
 
     switch (m_sides) {
       case 3u:
-        m_maze = std::make_shared<maze::TriangleMaze>(m_width, m_height, m_strategy);
-        break;
+        return std::make_shared<maze::TriangleMaze>(m_width, m_height, m_strategy);
       case 4u:
-        m_maze = std::make_shared<maze::SquareMaze>(m_width, m_height, m_strategy);
-        break;
+        return std::make_shared<maze::SquareMaze>(m_width, m_height, m_strategy);
       case 6u:
-        m_maze = std::make_shared<maze::HexagonMaze>(m_width, m_height, m_strategy);
-        break;
+        return std::make_shared<maze::HexagonMaze>(m_width, m_height, m_strategy);
       default:
-        break;
+        return nullptr;
     }
+  }
+
+  void
+  Game::recycleMaze(maze::MazeShPtr m) {
+    if (m == nullptr) {
+      return;
+    }
+
+    // Replace the spare maze with the same number of sides.
+    for (maze::MazeShPtr& spare : m_spares) {
+      if (spare->sides() == m->sides()) {
+        spare = m;
+        return;
+      }
+    }
+
+    m_spares.push_back(m);
+  }
+
+  void
+  Game::resetMaze() noexcept {
+    // Generate a new maze: the current one is reshaped in place
+    // if it has the right number of sides.
+    cancelGeneration();
+    recycleMaze(m_maze);
+    m_maze.reset();
+    m_seeded = false;
+
+    m_maze = createMaze();
 
     if (m_maze == nullptr) {
       error(
@@ -3,8 +3,14 @@
 
 # include <vector>
 # include <memory>
+# include <atomic>
+# include <thread>
+# include <exception>
+# include <cstdint>
 # include <core_utils/CoreObject.hh>
 # include "Maze.hh"
+# include "Random.hh"
+# include "Workspace.hh"
 
 namespace pge {
 
@@ -138,6 +144,42 @@ namespace pge {
       void
       setGenerationStrategy(const maze::Strategy& strategy) noexcept;
 
+      /**
+       * @brief - Select the growing tree strategy to generate the
+       *          maze. In case it is already selected, the next
+       *          policy to pick the cell to expand is used instead.
+       */
+      void
+      selectGrowingTree() noexcept;
+
+      /**
+       * @brief - Select the next fraction of dead ends to remove
+       *          from the maze after its generation, by steps of
+       *          25%. No dead end is removed by default.
+       */
+      void
+      nextBraidFraction() noexcept;
+
+      /**
+       * @brief - Switch between generating new mazes on a thread in
+       *          the background, while the current maze is still
+       *          displayed, and generating them in place for a part
+       *          of each frame so that they can be seen while they
+       *          are being built.
+       */
+      void
+      toggleBackgroundGeneration() noexcept;
+
+      /**
+       * @brief - Switch between generating new mazes as a whole and
+       *          splitting them in tiles generated on the threads of
+       *          the pool (see `tiles::generate`). This only changes
+       *          the mazes generated with a sequential strategy, and
+       *          gives another maze for the same seed.
+       */
+      void
+      toggleTiledGeneration() noexcept;
+
       /**
        * @brief - Defines the number of sides for each cell of
        *          the maze of the game.
@@ -147,11 +189,21 @@ namespace pge {
       setCellSidesCount(unsigned sides) noexcept;
 
       /**
-       * @brief - Performs the generation of a new maze.
+       * @brief - Performs the generation of a new maze. A new seed
+       *          is drawn for each generation.
        */
       void
       generateMaze();
 
+      /**
+       * @brief - Performs the generation of a new maze with the
+       *          specified seed: this allows to reproduce a maze
+       *          from the seed displayed in the status menu.
+       * @param seed - the seed to use for the generation.
+       */
+      void
+      generateMaze(std::uint64_t seed);
+
       /**
        * @brief - Loads the maze defined in the input file.
        * @param file - the file to use to load a maze from.
@@ -187,6 +239,69 @@ namespace pge {
       virtual void
       updateUI();
 
+      /**
+       * @brief - Replace the current maze with the one generated in
+       *          the background, once the worker is done. Nothing is
+       *          replaced in case the generation failed or has been
+       *          cancelled: the maze is kept as a spare instead (see
+       *          `recycleMaze`).
+       */
+      void
+      publishMaze();
+
+      /**
+       * @brief - Advance the generation of the displayed maze for at
+       *          most a frame's worth of time. Once the generation is
+       *          over the maze is braided if needed.
+       */
+      void
+      advanceGeneration();
+
+      /**
+       * @brief - Prepare the generation of the input maze with the
+       *          specified seed, reporting its progress to the
+       *          context of the game.
+       * @param m - the maze to generate.
+       * @param seed - the seed to use for the generation.
+       * @param parallel - whether the maze should be generated at
+       *                   once with the threads of the pool.
+       * @return - the generation of the maze.
+       */
+      std::unique_ptr<maze::Generation>
+      startGeneration(maze::Maze& m, std::uint64_t seed, bool parallel);
+
+      /**
+       * @brief - Interrupt the generation in progress if any, along
+       *          with the one waiting for it to stop. In case it runs
+       *          in the background, the worker is requested to stop
+       *          but not waited for: it is reaped by `step` once it
+       *          is done (see `publishMaze`).
+       */
+      void
+      cancelGeneration() noexcept;
+
+      /**
+       * @brief - Create a new maze (with all its walls closed) with
+       *          the dimensions, number of sides for cells and the
+       *          strategy defined by the internal attributes. A spare
+       *          maze with the same number of sides is reshaped when
+       *          available instead of allocating a new one.
+       * @return - the new maze or `null` if the configuration is
+       *           not supported.
+       */
+      maze::MazeShPtr
+      createMaze();
+
+      /**
+       * @brief - Keep a maze which is not used anymore so that its
+       *          memory can be reused by the next one with the same
+       *          number of sides (see `createMaze`). Only one maze is
+       *          kept for each number of sides.
+       * @param m - the maze to keep, can be `null`.
+       */
+      void
+      recycleMaze(maze::MazeShPtr m);
+
       /**
        * @brief - Used to reset the maze and create a new one with
        *          the dimensions and number of sides for cells as
@@ -231,6 +346,18 @@ namespace pge {
 
         // The current number of sides for each cell of the maze.
         MenuShPtr sides;
+
+        // The seed used to generate the current maze.
+        MenuShPtr seed;
+
+        // The fraction of dead ends removed after the generation.
+        MenuShPtr braid;
+
+        // Whether mazes are generated in the background.
+        MenuShPtr mode;
+
+        // Whether mazes are split in tiles generated in parallel.
+        MenuShPtr tiles;
       };
 
       /**
@@ -259,15 +386,135 @@ namespace pge {
        */
       maze::Strategy m_strategy;
 
+      /**
+       * @brief - The policy used by the growing tree strategy.
+       */
+      maze::growingtree::Policy m_policy;
+
+      /**
+       * @brief - The fraction of dead ends removed from the maze
+       *          after its generation (see `Maze::braid`).
+       */
+      float m_braid;
+
+      /**
+       * @brief - Whether new mazes are generated on a thread in the
+       *          background or in place at each frame.
+       */
+      bool m_background;
+
+      /**
+       * @brief - Whether the mazes generated with a sequential
+       *          strategy are split in tiles generated in parallel.
+       */
+      bool m_tiled;
+
       /**
        * @brief - The number of sides for the cells of the maze.
        */
       unsigned m_sides;
 
+      /**
+       * @brief - The generator providing the seed of each new
+       *          generation of the maze.
+       */
+      maze::Random m_seeds;
+
+      /**
+       * @brief - The seed used to generate the current maze. It
+       *          is displayed so that a maze can be reproduced.
+       */
+      std::uint64_t m_seed;
+
+      /**
+       * @brief - Whether the current maze has been generated with
+       *          the seed (as opposed to loaded or just created).
+       */
+      bool m_seeded;
+
+      /**
+       * @brief - The threads used by the strategies generating a
+       *          maze in parallel.
+       */
+      maze::ThreadPool m_pool;
+
       /**
        * @brief - The maze attached to the game.
        */
       maze::MazeShPtr m_maze;
+
+      /**
+       * @brief - The mazes not displayed anymore, at most one for
+       *          each number of sides. They are reshaped to create
+       *          the next mazes without allocating their walls.
+       */
+      std::vector<maze::MazeShPtr> m_spares;
+
+      /**
+       * @brief - The generation of the displayed maze in progress if
+       *          any: it is advanced at each frame so that the maze
+       *          can be seen while it is being built. This is only
+       *          used when mazes are not generated in the background.
+       */
+      std::unique_ptr<maze::Generation> m_generation;
+
+      /**
+       * @brief - The thread generating a new maze in the background
+       *          if any. The current maze is displayed until the new
+       *          one is ready.
+       */
+      std::thread m_worker;
+
+      /**
+       * @brief - The context attached to the generation in progress:
+       *          it is used to follow its progress and to request the
+       *          worker to stop the generation.
+       */
+      maze::Context m_context;
+
+      /**
+       * @brief - The buffers used to generate mazes.
+       *          They are kept between generations so that only the
+       *          first one (or a larger maze) allocates memory.
+       */
+      maze::Workspace m_workspace;
+
+      /**
+       * @brief - Set by the worker once it is done: the result of
+       *          the generation can then be read safely.
+       */
+      std::atomic_bool m_finished;
+
+      /**
+       * @brief - The maze generated by the worker. It is displayed
+       *          once the worker is done, or kept as a spare in case
+       *          the generation is cancelled or fails.
+       */
+      maze::MazeShPtr m_pending;
+
+      /**
+       * @brief - The error raised by the worker if any.
+       */
+      std::exception_ptr m_failure;
+
+      /**
+       * @brief - Whether the generation performed by the worker has
+       *          been cancelled: its result is discarded once it is
+       *          done.
+       */
+      bool m_abandoned;
+
+      /**
+       * @brief - Whether a new generation has been requested while
+       *          the worker of a cancelled one was still running. It
+       *          is started once the worker is done.
+       */
+      bool m_deferred;
+
+      /**
+       * @brief - The seed of the generation waiting for the worker.
+       */
+      std::uint64_t m_deferredSeed;
   };
 
   using GameShPtr = std::shared_ptr<Game>;
@@ -0,0 +1,14 @@
+
+# include "Adjacency.hh"
+
+namespace maze {
+
+  Adjacency::Adjacency() noexcept:
+    m_width(0u),
+    m_height(0u),
+    m_sides(0u),
+    m_neighbors(),
+    m_connected(true)
+  {}
+
+}
@@ -0,0 +1,99 @@
+#ifndef    ADJACENCY_HH
+# define   ADJACENCY_HH
+
+# include <vector>
+
+namespace maze {
+
+  class Adjacency {
+    public:
+
+      /// @brief - The value used for doors leading outside of the
+      /// maze.
+      static constexpr unsigned BORDER = ~0u;
+
+      /**
+       * @brief - Create a new empty adjacency table. Nothing can be
+       *          queried until it is built for a topology.
+       */
+      Adjacency() noexcept;
+
+      /**
+       * @brief - Whether this table was built for a maze with the
+       *          specified properties.
+       * @param width - the width of the maze.
+       * @param height - the height of the maze.
+       * @param sides - the number of sides of the cells.
+       * @return - `true` if the table describes such a maze.
+       */
+      bool
+      matches(unsigned width, unsigned height, unsigned sides) const noexcept;
+
+      /**
+       * @brief - Build the table for a maze with the specified
+       *          dimensions. The memory already allocated is reused
+       *          if possible.
+       * @param width - the width of the maze.
+       * @param height - the height of the maze.
+       */
+      template <typename Topology>
+      void
+      build(unsigned width, unsigned height);
+
+      /**
+       * @brief - Whether all the cells of the maze can be reached
+       *          from any of them. Some dimensions leave isolated
+       *          cells (typically triangular mazes with a single
+       *          column) which can't be part of a perfect maze.
+       * @return - `true` if the cells form a single component.
+       */
+      bool
+      connected() const noexcept;
+
+      /**
+       * @brief - Return the neighbors of the cell at the specified
+       *          linear index: there is one entry per door of the
+       *          cell, set to the linear index of the cell on the
+       *          other side or to `BORDER` if the door leads out of
+       *          the maze. The cell is assumed to be valid.
+       * @param id - the linear index of the cell.
+       * @return - a pointer to the neighbors of the cell.
+       */
+      const unsigned*
+      operator[](unsigned id) const noexcept;
+
+    private:
+
+      /**
+       * @brief - The width of the maze described by the table.
+       */
+      unsigned m_width;
+
+      /**
+       * @brief - The height of the maze described by the table.
+       */
+      unsigned m_height;
+
+      /**
+       * @brief - The number of doors of each cell.
+       */
+      unsigned m_sides;
+
+      /**
+       * @brief - The neighbors of each cell, laid out as a row of
+       *          `m_sides` values per cell.
+       */
+      std::vector<unsigned> m_neighbors;
+
+      /**
+       * @brief - Whether the cells form a single component. This is
+       *          computed when the table is built.
+       */
+      bool m_connected;
+  };
+
+}
+
+# include "Adjacency.hxx"
+
+#endif    /* ADJACENCY_HH */
@@ -0,0 +1,78 @@
+#ifndef    ADJACENCY_HXX
+# define   ADJACENCY_HXX
+
+# include "Adjacency.hh"
+
+namespace maze {
+
+  inline
+  bool
+  Adjacency::matches(unsigned width, unsigned height, unsigned sides) const noexcept {
+    return m_width == width && m_height == height && m_sides == sides;
+  }
+
+  template <typename Topology>
+  inline
+  void
+  Adjacency::build(unsigned width, unsigned height) {
+    m_width = width;
+    m_height = height;
+    m_sides = Topology::SIDES;
+
+    m_neighbors.resize(m_width * m_height * m_sides);
+
+    unsigned* out = m_neighbors.data();
+    for (unsigned y = 0u ; y < m_height ; ++y) {
+      for (unsigned x = 0u ; x < m_width ; ++x) {
+        unsigned closed = Topology::closed(x, y, m_width, m_height);
+
+        for (unsigned d = 0u ; d < Topology::SIDES ; ++d, ++out) {
+          *out = ((closed >> d) & 1u) ? BORDER : Topology::neighbor(x, y, m_width, d);
+        }
+      }
+    }
+
+    // Flood the cells from the first one: the table is kept by
+    // the maze so this is only done once for given dimensions.
+    unsigned size = m_width * m_height;
+    if (size == 0u) {
+      m_connected = true;
+      return;
+    }
+
+    std::vector<bool> reached(size, false);
+    std::vector<unsigned> toVisit(1u, 0u);
+    reached[0u] = true;
+    unsigned count = 1u;
+
+    while (!toVisit.empty()) {
+      const unsigned* cells = (*this)[toVisit.back()];
+      toVisit.pop_back();
+
+      for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+        if (cells[d] != BORDER && !reached[cells[d]]) {
+          reached[cells[d]] = true;
+          ++count;
+          toVisit.push_back(cells[d]);
+        }
+      }
+    }
+
+    m_connected = (count == size);
+  }
+
+  inline
+  bool
+  Adjacency::connected() const noexcept {
+    return m_connected;
+  }
+
+  inline
+  const unsigned*
+  Adjacency::operator[](unsigned id) const noexcept {
+    return m_neighbors.data() + id * m_sides;
+  }
+
+}
+
+#endif    /* ADJACENCY_HXX */
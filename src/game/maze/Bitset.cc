@@ -0,0 +1,36 @@
+
+# include "Bitset.hh"
+# include <algorithm>
+
+namespace maze {
+
+  Bitset::Bitset(unsigned size):
+    m_size(0u),
+    m_words()
+  {
+    reset(size);
+  }
+
+  void
+  Bitset::reset(unsigned size) {
+    m_size = size;
+    m_words.assign((m_size + WORD_BITS - 1u) / WORD_BITS, Word(0u));
+  }
+
+  void
+  Bitset::clear() noexcept {
+    std::fill(m_words.begin(), m_words.end(), Word(0u));
+  }
+
+  void
+  Bitset::fill() noexcept {
+    std::fill(m_words.begin(), m_words.end(), ~Word(0u));
+
+    // Keep the bits after the end of the set cleared.
+    unsigned extra = m_size % WORD_BITS;
+    if (extra != 0u) {
+      m_words.back() = (Word(1u) << extra) - 1u;
+    }
+  }
+
+}
@@ -0,0 +1,160 @@
+#ifndef    BITSET_HH
+# define   BITSET_HH
+
+# include <vector>
+# include <cstdint>
+
+namespace maze {
+  namespace bits {
+
+    /**
+     * @brief - Count the number of bits set in the input word.
+     * @param word - the word to analyze.
+     * @return - the number of bits set.
+     */
+    unsigned
+    count(std::uint64_t word) noexcept;
+
+    /**
+     * @brief - Return the position of the `n`-th bit set in the
+     *          input word, starting from the least significant
+     *          bit. The word is assumed to have at least `n + 1`
+     *          bits set.
+     * @param word - the word to analyze.
+     * @param n - the index of the set bit to find.
+     * @return - the position of the bit in the word.
+     */
+    unsigned
+    select(std::uint64_t word, unsigned n) noexcept;
+
+  }
+
+  class Bitset {
+    public:
+
+      /// @brief - The type of the words used to store the bits.
+      using Word = std::uint64_t;
+
+      /// @brief - The number of bits in a word.
+      static constexpr unsigned WORD_BITS = 64u;
+
+      /**
+       * @brief - Create a new bitset with the specified number of
+       *          bits, all of them being cleared.
+       * @param size - the number of bits in the set.
+       */
+      explicit
+      Bitset(unsigned size = 0u);
+
+      /**
+       * @brief - The number of bits in the set.
+       * @return - the number of bits.
+       */
+      unsigned
+      size() const noexcept;
+
+      /**
+       * @brief - Resize the bitset so that it holds the input number
+       *          of bits, all of them being cleared. The memory is
+       *          reused if possible.
+       * @param size - the new number of bits in the set.
+       */
+      void
+      reset(unsigned size);
+
+      /**
+       * @brief - Clear all the bits of the set.
+       */
+      void
+      clear() noexcept;
+
+      /**
+       * @brief - Set all the bits of the set.
+       */
+      void
+      fill() noexcept;
+
+      /**
+       * @brief - Whether the bit at the specified index is set. The
+       *          index is assumed to be valid.
+       * @param id - the index of the bit.
+       * @return - `true` if the bit is set.
+       */
+      bool
+      operator[](unsigned id) const noexcept;
+
+      /**
+       * @brief - Set the bit at the specified index. The index is
+       *          assumed to be valid.
+       * @param id - the index of the bit.
+       */
+      void
+      set(unsigned id) noexcept;
+
+      /**
+       * @brief - Clear the bit at the specified index. The index is
+       *          assumed to be valid.
+       * @param id - the index of the bit.
+       */
+      void
+      unset(unsigned id) noexcept;
+
+      /**
+       * @brief - Set the bit at the specified index with an atomic
+       *          operation: several threads can set bits sharing a
+       *          word at the same time. The index is assumed to be
+       *          valid.
+       * @param id - the index of the bit.
+       */
+      void
+      setConcurrently(unsigned id) noexcept;
+
+      /**
+       * @brief - Unset the bit at the specified index with an atomic
+       *          operation: several threads can modify bits sharing
+       *          a word at the same time. The index is assumed to be
+       *          valid.
+       * @param id - the index of the bit.
+       */
+      void
+      unsetConcurrently(unsigned id) noexcept;
+
+      /**
+       * @brief - Return the word holding the bits starting at the
+       *          index `id * WORD_BITS`. The index is assumed to be
+       *          valid.
+       * @param id - the index of the word.
+       * @return - the packed bits of the word.
+       */
+      Word
+      word(unsigned id) const noexcept;
+
+      /**
+       * @brief - Define all the bits of the word at the specified
+       *          index at once. The index is assumed to be valid
+       *          and the bits after the end of the set should not
+       *          be set.
+       * @param id - the index of the word.
+       * @param value - the packed bits of the word.
+       */
+      void
+      setWord(unsigned id, Word value) noexcept;
+
+    private:
+
+      /**
+       * @brief - The number of bits in the set.
+       */
+      unsigned m_size;
+
+      /**
+       * @brief - The packed bits of the set.
+       */
+      std::vector<Word> m_words;
+  };
+
+}
+
+# include "Bitset.hxx"
+
+#endif    /* BITSET_HH */
@@ -0,0 +1,79 @@
+#ifndef    BITSET_HXX
+# define   BITSET_HXX
+
+# include "Bitset.hh"
+
+namespace maze {
+  namespace bits {
+
+    inline
+    unsigned
+    count(std::uint64_t word) noexcept {
+      return __builtin_popcountll(word);
+    }
+
+    inline
+    unsigned
+    select(std::uint64_t word, unsigned n) noexcept {
+      // Drop the `n` lowest set bits and return the
+      // position of the next one.
+      for (unsigned id = 0u ; id < n ; ++id) {
+        word &= word - 1u;
+      }
+
+      return __builtin_ctzll(word);
+    }
+
+  }
+
+  inline
+  unsigned
+  Bitset::size() const noexcept {
+    return m_size;
+  }
+
+  inline
+  bool
+  Bitset::operator[](unsigned id) const noexcept {
+    return (m_words[id / WORD_BITS] >> (id % WORD_BITS)) & 1u;
+  }
+
+  inline
+  void
+  Bitset::set(unsigned id) noexcept {
+    m_words[id / WORD_BITS] |= (Word(1u) << (id % WORD_BITS));
+  }
+
+  inline
+  void
+  Bitset::unset(unsigned id) noexcept {
+    m_words[id / WORD_BITS] &= ~(Word(1u) << (id % WORD_BITS));
+  }
+
+  inline
+  void
+  Bitset::setConcurrently(unsigned id) noexcept {
+    __atomic_fetch_or(&m_words[id / WORD_BITS], Word(1u) << (id % WORD_BITS), __ATOMIC_RELAXED);
+  }
+
+  inline
+  void
+  Bitset::unsetConcurrently(unsigned id) noexcept {
+    __atomic_fetch_and(&m_words[id / WORD_BITS], ~(Word(1u) << (id % WORD_BITS)), __ATOMIC_RELAXED);
+  }
+
+  inline
+  Bitset::Word
+  Bitset::word(unsigned id) const noexcept {
+    return m_words[id];
+  }
+
+  inline
+  void
+  Bitset::setWord(unsigned id, Word value) noexcept {
+    m_words[id] = value;
+  }
+
+}
+
+#endif    /* BITSET_HXX */
@@ -1,57 +1,37 @@
 
 # include "Cell.hh"
+# include <string>
+# include <core_utils/CoreException.hh>
 
 namespace maze {
 
-  Cell::Cell(unsigned doors, bool open):
-    utils::CoreObject("cell"),
-
-    m_doors(doors, open)
-  {
-    setService("maze");
-  }
+  Cell::Cell(unsigned doors, std::uint8_t mask) noexcept:
+    m_doors(doors),
+    m_mask(mask)
+  {}
 
   unsigned
   Cell::doors() const noexcept {
-    return m_doors.size();
+    return m_doors;
+  }
+
+  std::uint8_t
+  Cell::mask() const noexcept {
+    return m_mask;
   }
 
   bool
   Cell::operator()(unsigned id) const {
-    if (id >= m_doors.size()) {
-      error(
+    if (id >= m_doors) {
+      throw utils::CoreException(
         "Failed to access door " + std::to_string(id),
-        "Cell only defines " + std::to_string(m_doors.size())
-      );
-    }
-
-    return m_doors[id];
-  }
-
-  void
-  Cell::open() {
-    for (unsigned id = 0u ; id < m_doors.size() ; ++id) {
-      m_doors[id] = true;
-    }
-  }
-
-  void
-  Cell::close() {
-    for (unsigned id = 0u ; id < m_doors.size() ; ++id) {
-      m_doors[id] = false;
-    }
-  }
-
-  void
-  Cell::toggle(unsigned id, bool open) {
-    if (id >= m_doors.size()) {
-      error(
-        "Failed to toggle door " + std::to_string(id),
-        "Cell only defines " + std::to_string(m_doors.size())
+        "cell",
+        "maze",
+        "Cell only defines " + std::to_string(m_doors)
       );
     }
 
-    m_doors[id] = open;
+    return (m_mask >> id) & 1u;
   }
 
 }
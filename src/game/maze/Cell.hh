@@ -1,22 +1,21 @@
 #ifndef    CELL_HH
 # define   CELL_HH
 
-# include <vector>
-# include <memory>
-# include <core_utils/CoreObject.hh>
+# include <cstdint>
 
 namespace maze {
 
-  class Cell: public utils::CoreObject {
+  class Cell {
     public:
 
       /**
        * @brief - Generate a new cell with the specified number of
-       *          doors.
+       *          doors and state for each of them.
        * @param doors - the numebr of doors for this cell.
-       * @param open - whether or not the cell is open at the start.
+       * @param mask - the state of the doors packed as a bitmask:
+       *               the bit `i` is set if the door `i` is open.
        */
-      Cell(unsigned doors, bool open = false);
+      Cell(unsigned doors, std::uint8_t mask) noexcept;
 
       /**
        * @brief - The number of doors for this cell.
@@ -25,6 +24,14 @@ namespace maze {
       unsigned
       doors() const noexcept;
 
+      /**
+       * @brief - The state of the doors of this cell packed as a
+       *          bitmask.
+       * @return - the mask of the doors of this cell.
+       */
+      std::uint8_t
+      mask() const noexcept;
+
       /**
        * @brief - Return whether the door at the input index is
        *          opened or not. In case the door is out of the
@@ -39,46 +46,22 @@ namespace maze {
       bool
       operator()(unsigned id) const;
 
-      /**
-       * @brief - Opens all the doors of this cell.
-       */
-      void
-      open();
-
-      /**
-       * @brief - Close all the doors of this cell.
-       */
-      void
-      close();
+    private:
 
       /**
-       * @brief - Toggle the status of the door at the specified
-       *          index. In case the index is not valid, we raise
-       *          an error.
-       * @param id - the index of the door.
-       * @param open - whether the door is open.
+       * @brief - The number of doors of this cell.
        */
-      void
-      toggle(unsigned id, bool open);
-
-    private:
+      std::uint8_t m_doors;
 
       /**
-       * @brief - The list of doors of this cell.
-       *          NOTE: We use a vector of bools and not a bitset
-       *          as the bitset requires to know the size of the
-       *          'vector' at compile time. We could probably use
-       *          a specialzied version of the cell class but it
-       *          seems like overkill.
-       *          As per this thread though, it seems unclear if
-       *          this is actually a performance tradeof:
-       *          https://stackoverflow.com/questions/36932684/c11-vectorbool-performance-issue-with-code-example
-       *          So for now it serves our purposes.
+       * @brief - The state of the doors of this cell. This is a
+       *          copy of the packed state stored in the maze: a
+       *          cell is a lightweight value which can be freely
+       *          created when querying the maze.
        */
-      std::vector<bool> m_doors;
+      std::uint8_t m_mask;
   };
 
-  using CellShPtr = std::shared_ptr<Cell>;
 }
 
 #endif    /* CELL_HH */
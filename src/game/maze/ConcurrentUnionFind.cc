@@ -0,0 +1,25 @@
+
+# include "ConcurrentUnionFind.hh"
+
+namespace maze {
+
+  ConcurrentUnionFind::ConcurrentUnionFind(unsigned size):
+    m_size(0u),
+    m_parents()
+  {
+    reset(size);
+  }
+
+  void
+  ConcurrentUnionFind::reset(unsigned size) {
+    if (size != m_size) {
+      m_parents.reset(new std::atomic<unsigned>[size]);
+      m_size = size;
+    }
+
+    for (unsigned id = 0u ; id < m_size ; ++id) {
+      m_parents[id].store(id, std::memory_order_relaxed);
+    }
+  }
+
+}
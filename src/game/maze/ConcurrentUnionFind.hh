@@ -0,0 +1,100 @@
+#ifndef    CONCURRENT_UNION_FIND_HH
+# define   CONCURRENT_UNION_FIND_HH
+
+# include <atomic>
+# include <memory>
+
+namespace maze {
+
+  /// @brief - A disjoint-set structure which can be used by several
+  /// threads at once without locks. Looking for the representative
+  /// of an element is wait-free: the paths are halved along the way
+  /// with a single attempt to update each parent. Merging sets is
+  /// lock-free and relies on a compare-and-swap of the parent of
+  /// one of the representatives.
+  /// As there is no rank to decide how trees are attached, the
+  /// representative with the highest priority (a hash of its index)
+  /// becomes the parent which keeps the trees shallow on average.
+  class ConcurrentUnionFind {
+    public:
+
+      /**
+       * @brief - Create a new disjoint-set structure where each of
+       *          the elements lives in its own set.
+       * @param size - the number of elements in the structure.
+       */
+      explicit
+      ConcurrentUnionFind(unsigned size = 0u);
+
+      /**
+       * @brief - The number of elements tracked by this structure.
+       * @return - the number of elements.
+       */
+      unsigned
+      size() const noexcept;
+
+      /**
+       * @brief - Reset the structure so that it contains the input
+       *          number of elements, each one in its own set. The
+       *          memory already allocated is reused if possible.
+       *          This should not be called concurrently with other
+       *          methods.
+       * @param size - the number of elements in the structure.
+       */
+      void
+      reset(unsigned size);
+
+      /**
+       * @brief - Return the representative of the set containing
+       *          the input element. In case other threads merge sets
+       *          concurrently, the result might not be current when
+       *          it is returned.
+       *          The element is assumed to be valid.
+       * @param id - the element to find.
+       * @return - the representative of the set of the element.
+       */
+      unsigned
+      find(unsigned id) noexcept;
+
+      /**
+       * @brief - Attach the representative of a set to an element of
+       *          another set. This is only valid when the caller has
+       *          exclusive ownership of the representative (for
+       *          example through a reservation): no other thread may
+       *          attach it concurrently.
+       * @param root - the representative to attach.
+       * @param parent - the element to attach it to.
+       */
+      void
+      link(unsigned root, unsigned parent) noexcept;
+
+      /**
+       * @brief - Merge the sets containing both elements.
+       * @param lhs - the first element.
+       * @param rhs - the second element.
+       * @return - `true` in case the sets were merged by this call
+       *           and `false` if both elements already belonged to
+       *           the same set.
+       */
+      bool
+      merge(unsigned lhs, unsigned rhs) noexcept;
+
+    private:
+
+      /**
+       * @brief - The number of elements in the structure.
+       */
+      unsigned m_size;
+
+      /**
+       * @brief - The parent of each element. A representative is
+       *          its own parent.
+       */
+      std::unique_ptr<std::atomic<unsigned>[]> m_parents;
+  };
+
+}
+
+# include "ConcurrentUnionFind.hxx"
+
+#endif    /* CONCURRENT_UNION_FIND_HH */
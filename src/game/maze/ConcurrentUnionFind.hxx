@@ -0,0 +1,73 @@
+#ifndef    CONCURRENT_UNION_FIND_HXX
+# define   CONCURRENT_UNION_FIND_HXX
+
+# include "ConcurrentUnionFind.hh"
+# include <utility>
+# include "Random.hh"
+
+namespace maze {
+
+  inline
+  unsigned
+  ConcurrentUnionFind::size() const noexcept {
+    return m_size;
+  }
+
+  inline
+  unsigned
+  ConcurrentUnionFind::find(unsigned id) noexcept {
+    unsigned parent = m_parents[id].load(std::memory_order_acquire);
+
+    while (parent != id) {
+      // Try to attach the element to its grand parent: in
+      // case another thread modified the parent already we
+      // just move on.
+      unsigned grand = m_parents[parent].load(std::memory_order_acquire);
+      if (grand != parent) {
+        m_parents[id].compare_exchange_weak(parent, grand, std::memory_order_acq_rel);
+      }
+
+      id = grand;
+      parent = m_parents[id].load(std::memory_order_acquire);
+    }
+
+    return id;
+  }
+
+  inline
+  void
+  ConcurrentUnionFind::link(unsigned root, unsigned parent) noexcept {
+    m_parents[root].store(parent, std::memory_order_release);
+  }
+
+  inline
+  bool
+  ConcurrentUnionFind::merge(unsigned lhs, unsigned rhs) noexcept {
+    while (true) {
+      lhs = find(lhs);
+      rhs = find(rhs);
+
+      if (lhs == rhs) {
+        return false;
+      }
+
+      // Attach the representative with the lowest priority:
+      // this is a total order so no cycle can be created.
+      std::uint64_t pl = Random::mix(lhs);
+      std::uint64_t pr = Random::mix(rhs);
+      if (pl > pr || (pl == pr && lhs > rhs)) {
+        std::swap(lhs, rhs);
+      }
+
+      // The attachment fails in case another thread attached
+      // the representative in the meantime: try again.
+      unsigned expected = lhs;
+      if (m_parents[lhs].compare_exchange_strong(expected, rhs, std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+  }
+
+}
+
+#endif    /* CONCURRENT_UNION_FIND_HXX */
@@ -0,0 +1,35 @@
+
+# include "Context.hh"
+# include <algorithm>
+
+namespace maze {
+
+  Context::Context() noexcept:
+    m_cancelled(false),
+
+    m_visited(0u),
+    m_opened(0u),
+    m_completion(0.0f)
+  {}
+
+  void
+  Context::reset() noexcept {
+    m_cancelled.store(false, std::memory_order_relaxed);
+
+    report(0u, 0u, 0.0f);
+  }
+
+  void
+  Context::accumulate(unsigned visited, unsigned opened, float completion) noexcept {
+    m_visited.fetch_add(visited, std::memory_order_relaxed);
+    m_opened.fetch_add(opened, std::memory_order_relaxed);
+
+    if (completion <= 0.0f) {
+      return;
+    }
+
+    float prev = m_completion.load(std::memory_order_relaxed);
+    while (!m_completion.compare_exchange_weak(prev, std::min(1.0f, prev + completion), std::memory_order_relaxed)) {}
+  }
+
+}
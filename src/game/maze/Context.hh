@@ -0,0 +1,116 @@
+#ifndef    CONTEXT_HH
+# define   CONTEXT_HH
+
+# include <atomic>
+
+namespace maze {
+
+  /// @brief - Shared state between a generation of a maze and the
+  /// code observing it, possibly from another thread: it allows to
+  /// request the generation to stop and to follow its progress. The
+  /// generation checks the request and publishes its progress at
+  /// coarse intervals (see `Generation::step`).
+  class Context {
+    public:
+
+      /**
+       * @brief - Create a new context with no progress and no
+       *          cancellation request.
+       */
+      Context() noexcept;
+
+      /**
+       * @brief - Request the generation using this context to stop.
+       *          The generation releases its memory and leaves the
+       *          maze with all its walls closed.
+       */
+      void
+      cancel() noexcept;
+
+      /**
+       * @brief - Whether the generation has been requested to stop.
+       * @return - `true` if the generation should stop.
+       */
+      bool
+      cancelled() const noexcept;
+
+      /**
+       * @brief - Clear the cancellation request and the progress so
+       *          that the context can be used for a new generation.
+       */
+      void
+      reset() noexcept;
+
+      /**
+       * @brief - The number of cells processed by the generation.
+       * @return - the number of cells visited so far.
+       */
+      unsigned
+      visited() const noexcept;
+
+      /**
+       * @brief - The number of walls opened by the generation.
+       * @return - the number of walls opened so far.
+       */
+      unsigned
+      opened() const noexcept;
+
+      /**
+       * @brief - An estimation of the progress of the generation.
+       * @return - the fraction of the generation completed, in the
+       *           range `[0; 1]`.
+       */
+      float
+      completion() const noexcept;
+
+      /**
+       * @brief - Publish the progress of the generation.
+       * @param visited - the number of cells visited so far.
+       * @param opened - the number of walls opened so far.
+       * @param completion - the estimated fraction of the
+       *                     generation completed.
+       */
+      void
+      report(unsigned visited, unsigned opened, float completion) noexcept;
+
+      /**
+       * @brief - Add the progress of a part of the generation to the
+       *          one already published. It is used by the strategies
+       *          running on several threads: each of them publishes
+       *          the work it did concurrently with the others.
+       * @param visited - the number of cells visited by this part.
+       * @param opened - the number of walls opened by this part.
+       * @param completion - the fraction of the whole generation
+       *                     represented by this part.
+       */
+      void
+      accumulate(unsigned visited, unsigned opened, float completion) noexcept;
+
+    private:
+
+      /**
+       * @brief - Whether the generation should stop.
+       */
+      std::atomic_bool m_cancelled;
+
+      /**
+       * @brief - The number of cells visited so far.
+       */
+      std::atomic<unsigned> m_visited;
+
+      /**
+       * @brief - The number of walls opened so far.
+       */
+      std::atomic<unsigned> m_opened;
+
+      /**
+       * @brief - The estimated fraction of the generation completed.
+       */
+      std::atomic<float> m_completion;
+  };
+
+}
+
+# include "Context.hxx"
+
+#endif    /* CONTEXT_HH */
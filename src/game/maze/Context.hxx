@@ -0,0 +1,48 @@
+#ifndef    CONTEXT_HXX
+# define   CONTEXT_HXX
+
+# include "Context.hh"
+
+namespace maze {
+
+  inline
+  void
+  Context::cancel() noexcept {
+    m_cancelled.store(true, std::memory_order_relaxed);
+  }
+
+  inline
+  bool
+  Context::cancelled() const noexcept {
+    return m_cancelled.load(std::memory_order_relaxed);
+  }
+
+  inline
+  unsigned
+  Context::visited() const noexcept {
+    return m_visited.load(std::memory_order_relaxed);
+  }
+
+  inline
+  unsigned
+  Context::opened() const noexcept {
+    return m_opened.load(std::memory_order_relaxed);
+  }
+
+  inline
+  float
+  Context::completion() const noexcept {
+    return m_completion.load(std::memory_order_relaxed);
+  }
+
+  inline
+  void
+  Context::report(unsigned visited, unsigned opened, float completion) noexcept {
+    m_visited.store(visited, std::memory_order_relaxed);
+    m_opened.store(opened, std::memory_order_relaxed);
+    m_completion.store(completion, std::memory_order_relaxed);
+  }
+
+}
+
+#endif    /* CONTEXT_HXX */
@@ -0,0 +1,126 @@
+
+# include "Generation.hh"
+# include <limits>
+# include <utility>
+# include <algorithm>
+# include "Maze.hh"
+# include "Context.hh"
+# include "Workspace.hh"
+
+namespace maze {
+
+  Generation::Generation(Maze& m, Workspace* workspace):
+    m_maze(m),
+
+    m_cellsVisited(0u),
+    m_wallsOpened(0u),
+
+    m_workspace(workspace),
+    m_ownWorkspace(),
+
+    m_context(nullptr),
+    m_done(false),
+    m_cancelled(false)
+  {
+    if (m_workspace != nullptr) {
+      m_workspace->reset();
+    }
+  }
+
+  Generation::~Generation() {}
+
+  float
+  Generation::completion() const noexcept {
+    unsigned size = m_maze.width() * m_maze.height();
+    if (size <= 1u) {
+      return (m_done ? 1.0f : 0.0f);
+    }
+
+    return std::min(1.0f, 1.0f * m_wallsOpened / (size - 1u));
+  }
+
+  bool
+  Generation::step(unsigned budget) {
+    if (m_done) {
+      return true;
+    }
+
+    if (m_context != nullptr && m_context->cancelled()) {
+      // Release the memory right away and leave the maze in a
+      // state which does not depend on when it was interrupted.
+      release();
+      m_maze.close();
+
+      m_cancelled = true;
+      m_done = true;
+    }
+    else {
+      m_done = advance(budget);
+    }
+
+    if (m_context != nullptr) {
+      m_context->report(
+        m_cellsVisited,
+        m_wallsOpened,
+        (m_done && !m_cancelled ? 1.0f : completion())
+      );
+    }
+
+    return m_done;
+  }
+
+  void
+  Generation::run() {
+    unsigned budget = (m_context != nullptr ? DEFAULT_STEP_BUDGET : std::numeric_limits<unsigned>::max());
+    while (!step(budget)) {}
+  }
+
+  void
+  Generation::release() {
+    // A workspace provided by the caller is kept for the next
+    // generation: only the buffers allocated for this one are
+    // released.
+    if (m_ownWorkspace != nullptr) {
+      m_ownWorkspace.reset();
+      m_workspace = nullptr;
+    }
+    else if (m_workspace != nullptr) {
+      m_workspace->reset();
+    }
+  }
+
+  Workspace&
+  Generation::workspace() {
+    if (m_workspace == nullptr) {
+      m_ownWorkspace = std::make_unique<Workspace>();
+      m_workspace = m_ownWorkspace.get();
+    }
+
+    return *m_workspace;
+  }
+
+  Batch::Batch(Maze& m, Process process):
+    Generation(m),
+
+    m_process(std::move(process))
+  {}
+
+  bool
+  Batch::advance(unsigned /*budget*/) {
+    m_process(m_maze, context());
+
+    // The maze is not complete in case the process stopped early:
+    // the next step cancels the generation.
+    if (context() != nullptr && context()->cancelled()) {
+      return false;
+    }
+
+    // The strategies generate perfect mazes.
+    unsigned size = m_maze.width() * m_maze.height();
+    m_cellsVisited = size;
+    m_wallsOpened = (size > 0u ? size - 1u : 0u);
+
+    return true;
+  }
+
+}
@@ -0,0 +1,256 @@
+#ifndef    GENERATION_HH
+# define   GENERATION_HH
+
+# include <memory>
+# include <functional>
+
+namespace maze {
+
+  /// @brief - Forward declaration of the maze class.
+  class Maze;
+
+  /// @brief - Forward declaration of the context class.
+  class Context;
+
+  /// @brief - Forward declaration of the workspace class.
+  class Workspace;
+
+  /// @brief - The budget used by each step when the generation
+  /// is run until it is over with a context: the cancellation is
+  /// checked after each of them.
+  constexpr unsigned DEFAULT_STEP_BUDGET = 4096u;
+
+  /// @brief - A generation of a maze which can be performed in
+  /// several steps: it allows to interleave the generation with
+  /// other work (such as rendering frames) and to observe the
+  /// maze while it is being built. Each step is given a budget
+  /// roughly expressed as a number of cells or walls to process.
+  /// The generation is over when the `step` method returns `true`.
+  class Generation {
+    public:
+
+      /**
+       * @brief - Create a new generation for the input maze. The
+       *          maze should outlive the generation.
+       * @param m - the maze to generate.
+       * @param workspace - the buffers to use for the generation.
+       *                    They are reset so that the arrays handed
+       *                    out to a previous generation are released.
+       *                    In case it is `null`, the generation
+       *                    allocates its own buffers when needed.
+       *                    A workspace should only be used by one
+       *                    generation at a time.
+       */
+      explicit
+      Generation(Maze& m, Workspace* workspace = nullptr);
+
+      /**
+       * @brief - Destruction of the generation.
+       */
+      virtual
+      ~Generation();
+
+      /**
+       * @brief - Whether the generation is over.
+       * @return - `true` if the maze is fully generated.
+       */
+      bool
+      done() const noexcept;
+
+      /**
+       * @brief - Whether the generation has been interrupted by
+       *          its context before being completed.
+       * @return - `true` if the generation was cancelled.
+       */
+      bool
+      cancelled() const noexcept;
+
+      /**
+       * @brief - The number of cells processed so far.
+       * @return - the number of cells visited.
+       */
+      unsigned
+      visited() const noexcept;
+
+      /**
+       * @brief - The number of walls opened so far.
+       * @return - the number of walls opened.
+       */
+      unsigned
+      opened() const noexcept;
+
+      /**
+       * @brief - An estimation of the progress of the generation.
+       *          The default implementation assumes that the maze
+       *          is perfect: it has exactly one less wall opened
+       *          than it has cells.
+       * @return - the fraction of the generation completed.
+       */
+      virtual
+      float
+      completion() const noexcept;
+
+      /**
+       * @brief - Attach a context to the generation: it is checked
+       *          for cancellation before each step and receives the
+       *          progress after each of them.
+       * @param context - the context to attach or `null` to detach
+       *                  the current one. It should outlive the
+       *                  generation.
+       */
+      void
+      setContext(Context* context) noexcept;
+
+      /**
+       * @brief - Advance the generation by at most the input amount
+       *          of work. Nothing happens if the generation is over.
+       *          In case the context requests it, the generation is
+       *          cancelled: the memory it uses is released and the
+       *          maze is left with all its walls closed.
+       * @param budget - the number of cells or walls to process.
+       * @return - `true` if the generation is over.
+       */
+      bool
+      step(unsigned budget);
+
+      /**
+       * @brief - Perform the generation until it is over. In case a
+       *          context is attached, it is performed by steps so
+       *          that it can be cancelled.
+       */
+      void
+      run();
+
+    protected:
+
+      /**
+       * @brief - Interface method to advance the generation by at
+       *          most the input amount of work. Inheriting classes
+       *          keep the state of the generation between two calls.
+       * @param budget - the number of cells or walls to process.
+       * @return - `true` if the generation is over.
+       */
+      virtual
+      bool
+      advance(unsigned budget) = 0;
+
+      /**
+       * @brief - Interface method to release the memory used by the
+       *          generation when it is cancelled. The default
+       *          implementation releases the buffers allocated by
+       *          the generation, or resets the workspace provided
+       *          by the caller so that it keeps its capacity.
+       */
+      virtual
+      void
+      release();
+
+      /**
+       * @brief - The buffers to use for the generation. They are
+       *          allocated on first use if none were provided.
+       * @return - the workspace of the generation.
+       */
+      Workspace&
+      workspace();
+
+      /**
+       * @brief - The context attached to the generation if any.
+       * @return - the context or `null` if none is attached.
+       */
+      Context*
+      context() const noexcept;
+
+    protected:
+
+      /**
+       * @brief - The maze being generated.
+       */
+      Maze& m_maze;
+
+      /**
+       * @brief - The number of cells processed so far. Inheriting
+       *          classes keep it up to date.
+       */
+      unsigned m_cellsVisited;
+
+      /**
+       * @brief - The number of walls opened so far. Inheriting
+       *          classes keep it up to date.
+       */
+      unsigned m_wallsOpened;
+
+    private:
+
+      /**
+       * @brief - The buffers used by the generation if any.
+       */
+      Workspace* m_workspace;
+
+      /**
+       * @brief - The buffers allocated by the generation in case
+       *          none were provided.
+       */
+      std::unique_ptr<Workspace> m_ownWorkspace;
+
+      /**
+       * @brief - The context attached to the generation if any.
+       */
+      Context* m_context;
+
+      /**
+       * @brief - Whether the generation is over.
+       */
+      bool m_done;
+
+      /**
+       * @brief - Whether the generation has been cancelled.
+       */
+      bool m_cancelled;
+  };
+
+  /// @brief - A generation performed in a single step, for the
+  /// strategies running on several threads. They receive the
+  /// context of the generation and check it themselves: in case
+  /// they are interrupted, the generation is cancelled at the
+  /// next step.
+  class Batch: public Generation {
+    public:
+
+      /// @brief - Convenience define for the function generating
+      /// the maze: it receives the context of the generation,
+      /// which may be `null`.
+      using Process = std::function<void(Maze&, Context*)>;
+
+      /**
+       * @brief - Create a new generation running the input process
+       *          on its first step.
+       * @param m - the maze to generate.
+       * @param process - the function generating the maze.
+       */
+      Batch(Maze& m, Process process);
+
+    protected:
+
+      /**
+       * @brief - Implementation of the interface method: the whole
+       *          maze is generated whatever the budget.
+       * @param budget - ignored.
+       * @return - `true` unless the process was interrupted by the
+       *           context.
+       */
+      bool
+      advance(unsigned budget) override;
+
+    private:
+
+      /**
+       * @brief - The function generating the maze.
+       */
+      Process m_process;
+  };
+
+}
+
+# include "Generation.hxx"
+
+#endif    /* GENERATION_HH */
@@ -0,0 +1,46 @@
+#ifndef    GENERATION_HXX
+# define   GENERATION_HXX
+
+# include "Generation.hh"
+
+namespace maze {
+
+  inline
+  bool
+  Generation::done() const noexcept {
+    return m_done;
+  }
+
+  inline
+  bool
+  Generation::cancelled() const noexcept {
+    return m_cancelled;
+  }
+
+  inline
+  unsigned
+  Generation::visited() const noexcept {
+    return m_cellsVisited;
+  }
+
+  inline
+  unsigned
+  Generation::opened() const noexcept {
+    return m_wallsOpened;
+  }
+
+  inline
+  void
+  Generation::setContext(Context* context) noexcept {
+    m_context = context;
+  }
+
+  inline
+  Context*
+  Generation::context() const noexcept {
+    return m_context;
+  }
+
+}
+
+#endif    /* GENERATION_HXX */
@@ -1,10 +1,19 @@
 
 # include "Generator.hh"
-# include <numeric>
-# include <unordered_set>
-# include <stack>
+# include <algorithm>
+# include <functional>
+# include <initializer_list>
 # include "Maze.hh"
-# include "Opening.hh"
+# include "Topology.hh"
+# include "Bitset.hh"
+# include "UnionFind.hh"
+# include "Random.hh"
+# include "RowGenerator.hh"
+# include "ThreadPool.hh"
+# include "ConcurrentUnionFind.hh"
+# include "Generation.hh"
+# include "Workspace.hh"
+# include "Context.hh"
 
 namespace maze {
 
@@ -17,120 +26,448 @@ namespace maze {
         return "Randomized Prim";
       case Strategy::DepthFirst:
         return "Depth-first";
+      case Strategy::Wilson:
+        return "Wilson";
+      case Strategy::AldousBroder:
+        return "Aldous-Broder";
+      case Strategy::Eller:
+        return "Eller";
+      case Strategy::BinaryTree:
+        return "Binary tree";
+      case Strategy::Sidewinder:
+        return "Sidewinder";
+      case Strategy::ParallelKruskal:
+        return "Parallel Kruskal";
+      case Strategy::Boruvka:
+        return "Boruvka";
+      case Strategy::RecursiveDivision:
+        return "Recursive division";
+      case Strategy::GrowingTree:
+        return "Growing tree";
       default:
         return "unknown";
     }
   }
 
+  bool
+  strategyIsParallel(const Strategy& st) noexcept {
+    return
+      st == Strategy::ParallelKruskal ||
+      st == Strategy::Boruvka ||
+      st == Strategy::RecursiveDivision;
+  }
+
   namespace kruksal {
 
-    /// @brief - Convenience structure defining a wall: this helps
-    /// speeding up the process of picking a door.
-    struct Door {
-      // The x coordinate of the starting cell.
-      unsigned x;
+    /// @brief - The number of walls processed by each task of the
+    /// parallel generation.
+    constexpr unsigned GRAIN = 4096u;
 
-      // The y coordinate of the starting cell.
-      unsigned y;
+    /// @brief - The number of walls considered at each round of
+    /// the parallel generation, for each thread.
+    constexpr unsigned WINDOW = 8u * GRAIN;
 
-      // The index of the door.
-      unsigned d;
-    };
+    /// @brief - Marker for a region which is not reserved.
+    constexpr unsigned FREE = ~0u;
 
     void
-    generate(Maze& m) {
-      // Generation variables.
-      unsigned size = m.width() * m.height();
-      std::vector<unsigned> ids(size, 0u);
-      std::vector<Door> doors;
+    generate(Maze& m, std::uint64_t seed) {
+      topology::dispatch(m.sides(),
+        [&m, seed](auto t) {
+          generate<decltype(t)>(m, seed);
+        }
+      );
+    }
+
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context) {
+      topology::dispatch(m.sides(),
+        [&m, seed, &pool, context](auto t) {
+          generate<decltype(t)>(m, seed, pool, context);
+        }
+      );
+    }
+
+    /// @brief - The generation with the Kruksal algorithm performed
+    /// in several steps: the walls are first gathered, then shuffled
+    /// and finally swept.
+    template <typename Topology>
+    class Stepper: public Generation {
+      public:
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         */
+        Stepper(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_phase(Phase::Gather),
+          m_rng(seed),
+          m_regions(this->workspace().regions(m.width() * m.height())),
+          m_doors(this->workspace().allocate<Door>(m.width() * m.height() * Topology::SLOTS)),
+          m_count(0u),
+          m_next(0u)
+        {
+          // Close all doors in the maze.
+          m.close();
+        }
 
-      std::iota(ids.begin(), ids.end(), 0);
+        /**
+         * @brief - Register the walls between the input cell and
+         *          another cell of the maze. Each wall is shared by
+         *          two cells: it is only registered from the cell
+         *          owning it so that it is only considered once.
+         * @param m - the maze used to query properties about cells.
+         * @param x - the x coordinate of the cell.
+         * @param y - the y coordinate of the cell.
+         * @param doors - output argument receiving the walls. It
+         *                should have room for a wall per slot.
+         * @return - the number of walls registered.
+         */
+        static unsigned
+        gather(Maze& m, unsigned x, unsigned y, Door* doors) {
+          unsigned id = m.linear(x, y);
+          const unsigned* neighbors = m.adjacency()[id];
+          bool inv = Topology::inverted(x, y);
+
+          bool boxed = true;
+          unsigned slot = 0u;
+          unsigned count = 0u;
+
+          for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+            if (neighbors[d] == Adjacency::BORDER) {
+              continue;
+            }
 
-      // Prepare the list of doors to consider.
-      for (unsigned id = 0u ; id < size ; ++id) {
-        unsigned x = id % m.width();
-        unsigned y = id / m.width();
+            boxed = false;
+            if (Topology::owns(d, inv, slot)) {
+              doors[count] = Door{id, neighbors[d], m.slotIndex(x, y, slot)};
+              ++count;
+            }
+          }
 
-        Opening o(x, y, m.sides(), m.inverted(x, y));
-        m.prepareOpening(o);
+          if (boxed) {
+            m.error("Cell " + std::to_string(x) + "x" + std::to_string(y) + " is boxed, can't open wall");
+          }
 
-        bool boxed = false;
-        o.breach(boxed);
-        if (boxed) {
-          m.error("Cell " + std::to_string(x) + "x" + std::to_string(y) + " is boxed, can't open wall");
+          return count;
         }
 
-        for (unsigned d = 0u ; d < m.sides() ; ++d) {
-          if (!o.canBeOpened(d)) {
-            continue;
+      protected:
+
+        bool
+        advance(unsigned budget) override {
+          unsigned w = m_maze.width();
+          unsigned size = w * m_maze.height();
+
+          // Prepare the list of doors to consider.
+          for ( ; m_phase == Phase::Gather && budget > 0u ; --budget) {
+            m_count += gather(m_maze, m_next % w, m_next / w, m_doors + m_count);
+            ++m_cellsVisited;
+
+            ++m_next;
+            if (m_next == size) {
+              m_phase = Phase::Shuffle;
+              m_next = m_count;
+            }
+          }
+
+          // Shuffle the walls once, in the same way as the method
+          // `Random::shuffle`: the generation then only consists
+          // in a single sweep over the list.
+          for ( ; m_phase == Phase::Shuffle && budget > 0u ; --budget) {
+            if (m_next <= 1u) {
+              m_phase = Phase::Sweep;
+              m_next = 0u;
+              break;
+            }
+
+            std::swap(m_doors[m_next - 1u], m_doors[m_rng.bounded(m_next)]);
+            --m_next;
+          }
+
+          // The algorithm used is taken from this article (in French):
+          // https://fr.wikipedia.org/wiki/Mod%C3%A9lisation_math%C3%A9matique_d%27un_labyrinthe#Fusion_al%C3%A9atoire_de_chemins
+          unsigned walls = size - 1u;
+
+          for ( ; m_phase == Phase::Sweep && budget > 0u ; --budget) {
+            if (m_next >= m_count || m_wallsOpened >= walls) {
+              return true;
+            }
+
+            const Door& door = m_doors[m_next];
+            ++m_next;
+
+            // In case both cells already belong to the same
+            // region the wall stays closed: merging regions
+            // fails in this case.
+            if (!m_regions.merge(door.id, door.other)) {
+              continue;
+            }
+
+            // Open the wall between both cells.
+            m_maze.m_walls.set(door.wall);
+
+            ++m_wallsOpened;
           }
 
-          doors.push_back(Door{x, y, d});
+          return false;
+        }
+
+      private:
+
+        /// @brief - The phases of the generation.
+        enum class Phase {
+          Gather,
+          Shuffle,
+          Sweep
+        };
+
+        /**
+         * @brief - The current phase of the generation.
+         */
+        Phase m_phase;
+
+        /**
+         * @brief - The random generator used to shuffle the walls.
+         */
+        Random m_rng;
+
+        /**
+         * @brief - The regions of connected cells.
+         */
+        UnionFind& m_regions;
+
+        /**
+         * @brief - The walls to consider, allocated from the
+         *          workspace.
+         */
+        Door* m_doors;
+
+        /**
+         * @brief - The number of walls to consider.
+         */
+        unsigned m_count;
+
+        /**
+         * @brief - The next cell to gather, the number of walls
+         *          left to shuffle or the next wall to consider
+         *          depending on the phase.
+         */
+        unsigned m_next;
+    };
+
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace) {
+      std::unique_ptr<Generation> g;
+      topology::dispatch(m.sides(),
+        [&m, seed, workspace, &g](auto t) {
+          g = std::make_unique<Stepper<decltype(t)>>(m, seed, workspace);
+        }
+      );
+
+      return g;
+    }
+
+    template <typename Topology>
+    bool
+    shuffled(Maze& m, std::uint64_t seed, std::vector<Door>& doors, Context* context) {
+      unsigned w = m.width();
+      unsigned h = m.height();
+
+      auto interrupted = [context]() {
+        return context != nullptr && context->cancelled();
+      };
+
+      doors.resize(w * h * Topology::SLOTS);
+      unsigned count = 0u;
+
+      for (unsigned y = 0u ; y < h ; ++y) {
+        if (interrupted()) {
+          return false;
+        }
+
+        for (unsigned x = 0u ; x < w ; ++x) {
+          count += Stepper<Topology>::gather(m, x, y, doors.data() + count);
         }
       }
 
-      // Close all doors in the maze.
-      m.close();
+      doors.resize(count);
 
-      // The algorithm used is taken from this article (in French):
-      // https://fr.wikipedia.org/wiki/Mod%C3%A9lisation_math%C3%A9matique_d%27un_labyrinthe#Fusion_al%C3%A9atoire_de_chemins
-      unsigned opened = 0u;
-      unsigned processed = 0u;
-      unsigned walls = size - 1u;
+      // Shuffle the walls in the same way as `Random::shuffle`,
+      // checking the context once per window of walls.
+      Random rng(seed);
 
-      // As long as we didnt open enough walls.
-      while (opened < walls) {
-        bool valid = false;
+      for (unsigned id = count ; id > 1u ; --id) {
+        if (id % WINDOW == 0u && interrupted()) {
+          return false;
+        }
 
-        while (!valid) {
-          valid = true;
+        std::swap(doors[id - 1u], doors[rng.bounded(id)]);
+      }
 
-          // Pick a random wall to open. Once done, move it to the
-          // end of the list so that it is not considered anymore.
-          unsigned id = std::rand() % (doors.size() - 1u - processed);
-          Door door = doors[id];
-          std::swap(doors[id], doors[doors.size() - 1u - processed]);
-          ++processed;
+      return true;
+    }
 
-          unsigned id1 = m.linear(door.x, door.y);
-          unsigned inv1 = m.inverted(door.x, door.y);
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      Stepper<Topology> g(m, seed);
+      g.run();
+    }
 
-          // Compute the cell on the other side of the door.
-          unsigned id2 = m.idFromDoorAndCell(door.x, door.y, door.d);
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context) {
+      // Nothing to gain from the reservations with a single
+      // thread: the sequential sweep gives the same result.
+      if (pool.size() == 1u) {
+        Stepper<Topology> g(m, seed);
+        g.setContext(context);
+        g.run();
+        return;
+      }
 
-          // Consistency check.
-          if (id2 > size) {
-            m.error(
-              "Failed to generate maze",
-              "Requested access to cell " + std::to_string(id2) + " when only " +
-              std::to_string(size) + " are available"
-            );
-          }
+      unsigned size = m.width() * m.height();
+      std::vector<Door> doors;
 
-          // Check if the cell already belongs to the same
-          // region: if yes, we have to pick another wall.
-          if(ids[id1] == ids[id2]) {
-            valid = false;
-            continue;
-          }
+      if (!shuffled<Topology>(m, seed, doors, context)) {
+        return;
+      }
+
+      m.close();
+
+      if (context != nullptr) {
+        context->accumulate(size, 0u, 0.0f);
+      }
+
+      // The algorithm is the deterministic reservations from:
+      // https://www.cs.cmu.edu/~jshun/determinism.pdf
+      // At each round a window of the next walls is processed
+      // in parallel. Each wall looks for the regions of both
+      // its cells and reserves them, the smallest index in the
+      // sequential order winning. A wall owning the reservation
+      // of one of its regions attaches it to the other one: no
+      // wall before it in the sequential order could touch this
+      // region, so the sequential sweep would also open it.
+      // The other walls are considered again at the next round.
+      ConcurrentUnionFind regions(size);
+      std::unique_ptr<std::atomic<unsigned>[]> reserved(new std::atomic<unsigned>[size]);
+      for (unsigned id = 0u ; id < size ; ++id) {
+        reserved[id].store(FREE, std::memory_order_relaxed);
+      }
+
+      // The walls of the window (as indices in the sequential
+      // order) along with the regions found for them. A wall
+      // which is done with is marked as `FREE`.
+      unsigned window = WINDOW * pool.size();
+      std::vector<unsigned> current;
+      std::vector<unsigned> roots(2u * window);
+      current.reserve(window);
+
+      unsigned next = 0u;
 
-          // Open the wall for both cells.
-          m.m_cells[id1].toggle(door.d, true);
-          m.m_cells[id2].toggle(m.opposite(door.d, inv1), true);
+      while (next < doors.size() || !current.empty()) {
+        // The rounds depend on each other: the generation can only
+        // stop in between two of them.
+        if (context != nullptr && context->cancelled()) {
+          return;
+        }
+
+        // Fill the window with new walls after the ones left
+        // from the previous round, preserving the order.
+        while (current.size() < window && next < doors.size()) {
+          current.push_back(next);
+          ++next;
+        }
 
-          // And equalize the identifiers for both regions.
-          unsigned toReplace = std::max(ids[id1], ids[id2]);
-          unsigned newArea = std::min(ids[id1], ids[id2]);
+        unsigned count = static_cast<unsigned>(current.size());
+        unsigned tasks = (count + GRAIN - 1u) / GRAIN;
+
+        // Reserve the regions of each wall.
+        pool.run(tasks,
+          [&](unsigned task, unsigned /*thread*/) {
+            unsigned end = std::min(count, (task + 1u) * GRAIN);
+
+            for (unsigned id = task * GRAIN ; id < end ; ++id) {
+              const Door& door = doors[current[id]];
+              unsigned lhs = regions.find(door.id);
+              unsigned rhs = regions.find(door.other);
+
+              // Both cells are connected already: the wall
+              // stays closed.
+              if (lhs == rhs) {
+                current[id] = FREE;
+                roots[2u * id] = FREE;
+                continue;
+              }
+
+              roots[2u * id] = lhs;
+              roots[2u * id + 1u] = rhs;
+
+              for (unsigned root : {lhs, rhs}) {
+                unsigned prev = reserved[root].load(std::memory_order_relaxed);
+                while (current[id] < prev &&
+                       !reserved[root].compare_exchange_weak(prev, current[id], std::memory_order_relaxed))
+                {}
+              }
+            }
+          }
+        );
+
+        // Commit the walls owning one of their reservations.
+        pool.run(tasks,
+          [&](unsigned task, unsigned /*thread*/) {
+            unsigned end = std::min(count, (task + 1u) * GRAIN);
+            unsigned opened = 0u;
+
+            for (unsigned id = task * GRAIN ; id < end ; ++id) {
+              if (current[id] == FREE) {
+                continue;
+              }
+
+              unsigned lhs = roots[2u * id];
+              unsigned rhs = roots[2u * id + 1u];
+
+              if (reserved[lhs].load(std::memory_order_relaxed) == current[id]) {
+                regions.link(lhs, rhs);
+              }
+              else if (reserved[rhs].load(std::memory_order_relaxed) == current[id]) {
+                regions.link(rhs, lhs);
+              }
+              else {
+                continue;
+              }
+
+              m.m_walls.setConcurrently(doors[current[id]].wall);
+              current[id] = FREE;
+              ++opened;
+            }
 
-          for (unsigned id = 0u ; id < size ; ++id) {
-            if (ids[id] == toReplace) {
-              ids[id] = newArea;
+            if (context != nullptr && opened > 0u) {
+              context->accumulate(0u, opened, 1.0f * opened / (size - 1u));
             }
           }
+        );
+
+        // Release the reservations and keep the walls which
+        // need to be considered again.
+        unsigned kept = 0u;
+        for (unsigned id = 0u ; id < count ; ++id) {
+          if (roots[2u * id] != FREE) {
+            reserved[roots[2u * id]].store(FREE, std::memory_order_relaxed);
+            reserved[roots[2u * id + 1u]].store(FREE, std::memory_order_relaxed);
+          }
+
+          if (current[id] != FREE) {
+            current[kept] = current[id];
+            ++kept;
+          }
         }
 
-        // Opened one more wall.
-        ++opened;
+        current.resize(kept);
       }
     }
 
@@ -140,41 +477,25 @@ namespace maze {
 
     /// @brief - Convenience structure describing a wall.
     struct Wall {
-      // The x coordinate of the starting cell.
-      unsigned xO;
-
-      // The y coordinate of the starting cell.
-      unsigned yO;
-
-      // The x coordinate of the destination cell.
-      unsigned xE;
+      // The linear index of the destination cell.
+      unsigned to;
 
-      // The y coordinate of the destination cell.
-      unsigned yE;
-
-      // The door connected both cells.
-      unsigned door;
+      // The index of the wall in the walls of the maze.
+      unsigned wall;
     };
 
     /// @brief - Convenience structure allowing to keep a list
-    /// of walls and pick one of them at random while keeping
-    /// a reasonable deletion time.
+    /// of walls and pick one of them at random in constant time.
+    /// The walls are kept in a dense array: picking one of them
+    /// swaps it with the last one and shrinks the array. Each wall
+    /// of the maze is registered at most once so the array is
+    /// allocated once with room for all of them.
     struct Walls {
-      /// @brief - A convenience define to reference a list of
-      /// indices.
-      using Indices = std::unordered_set<unsigned>;
-
-      /// @brief- Iterating over the indices.
-      using IndicesIt = Indices::const_iterator;
-
       // The walls' data.
-      std::vector<Wall> data;
-
-      // The status of elements that are used.
-      Indices used;
+      Wall* data;
 
-      // The list of free indices.
-      Indices free;
+      // The number of walls in the list.
+      unsigned count;
 
       /**
        * @brief - Push back an element in the walls' data.
@@ -182,20 +503,8 @@ namespace maze {
        */
       void
       push_back(const Wall& w) noexcept {
-        // If no indices are free, create a new one.
-        if (free.empty()) {
-          used.insert(data.size());
-          data.push_back(w);
-
-          return;
-        }
-
-        // Otherwise, use a free index.
-        unsigned id = *free.begin();
-        free.erase(id);
-
-        used.insert(id);
-        data[id] = w;
+        data[count] = w;
+        ++count;
       }
 
       /**
@@ -204,7 +513,7 @@ namespace maze {
        */
       bool
       empty() const noexcept {
-        return data.size() == free.size();
+        return count == 0u;
       }
 
       /**
@@ -213,209 +522,2157 @@ namespace maze {
        */
       std::size_t
       size() const noexcept {
-        return used.size();
+        return count;
       }
 
       /**
-       * @brief - Select a random wall from the ones registered.
+       * @brief - Select a random wall from the ones registered and
+       *          remove it from the list.
+       * @param rng - the generator used to pick the wall.
        * @return - the randomly picked wall.
        */
       Wall
-      pick() {
+      pick(Random& rng) {
         // In case no element are available, this is a problem.
         if (empty()) {
           throw utils::CoreException("Unable to pick wall", "prim", "maze", "No wall left");
         }
 
-        // Pick a random element among the used ones.
-        unsigned id = std::rand() % used.size();
+        // Pick a random element and move the last one in its
+        // place so that the array stays dense.
+        unsigned id = rng.bounded(count);
+
+        Wall w = data[id];
+        --count;
+        data[id] = data[count];
+
+        return w;
+      }
+    };
 
-        // Find the corresponding index in the data structure.
-        IndicesIt it = used.cbegin();
-        unsigned c = 0u;
-        while (c < id && it != used.cend()) {
-          ++c;
-          ++it;
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      topology::dispatch(m.sides(),
+        [&m, seed](auto t) {
+          generate<decltype(t)>(m, seed);
         }
+      );
+    }
 
-        if (c < id) {
-          throw utils::CoreException(
-            "Unable to pick wall",
-            "prim",
-            "maze",
-            "Requested index " + std::to_string(id) + " but could only reach " + std::to_string(c)
-          );
+    /// @brief - The generation with the Prim algorithm performed
+    /// in several steps.
+    template <typename Topology>
+    class Stepper: public Generation {
+      public:
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         */
+        Stepper(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_rng(seed),
+          m_walls{this->workspace().allocate<Wall>(m.width() * m.height() * Topology::SLOTS), 0u},
+          m_visited(this->workspace().cells(m.width() * m.height()))
+        {
+          // We start with a grid full of walls.
+          m.close();
+
+          // Pick a random cell and initialize the list of walls.
+          unsigned w = m.width();
+          unsigned id = m_rng.bounded(w * m.height());
+
+          expand(id % w, id / w);
+          m_visited.set(id);
+          ++m_cellsVisited;
         }
 
-        // Select the wall.
-        Wall w = data[*it];
+      protected:
 
-        // Mark the spot as free again.
-        free.insert(*it);
-        used.erase(it);
+        bool
+        advance(unsigned budget) override {
+          // The algorithm is taken from here:
+          // https://en.wikipedia.org/wiki/Maze_generation_algorithm#Randomized_Prim's_algorithm
+          unsigned w = m_maze.width();
 
-        return w;
-      }
+          // Continue processing while there are walls to analyze.
+          for ( ; !m_walls.empty() && budget > 0u ; --budget) {
+            // Pick a random wall.
+            Wall wall = m_walls.pick(m_rng);
+
+            // Check whether the destination cell is visited.
+            if (m_visited[wall.to]) {
+              continue;
+            }
+
+            m_visited.set(wall.to);
+            ++m_cellsVisited;
+
+            // Open the wall between both cells.
+            m_maze.m_walls.set(wall.wall);
+            ++m_wallsOpened;
+
+            // Generate the neighbors of the cell.
+            expand(wall.to % w, wall.to / w);
+          }
+
+          return m_walls.empty();
+        }
+
+      private:
+
+        /**
+         * @brief - Register the walls leading from the input cell
+         *          to cells not visited yet.
+         * @param x - the x coordinate of the cell.
+         * @param y - the y coordinate of the cell.
+         */
+        void
+        expand(unsigned x, unsigned y) {
+          const unsigned* neighbors = m_maze.adjacency()[m_maze.linear(x, y)];
+
+          for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+            unsigned id = neighbors[d];
+
+            // Prevent cells to be generated if they are out of
+            // the maze or if they already exist.
+            if (id == Adjacency::BORDER || m_visited[id]) {
+              continue;
+            }
+
+            m_walls.push_back(Wall{id, m_maze.template wall<Topology>(x, y, d, id)});
+          }
+        }
+
+      private:
+
+        /**
+         * @brief - The random generator used to pick the walls.
+         */
+        Random m_rng;
+
+        /**
+         * @brief - The walls leading to cells not visited yet.
+         */
+        Walls m_walls;
+
+        /**
+         * @brief - The cells already visited.
+         */
+        Bitset& m_visited;
     };
 
-    std::string
-    hash(unsigned x, unsigned y) noexcept {
-      return std::to_string(x) + "x" + std::to_string(y);
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace) {
+      std::unique_ptr<Generation> g;
+      topology::dispatch(m.sides(),
+        [&m, seed, workspace, &g](auto t) {
+          g = std::make_unique<Stepper<decltype(t)>>(m, seed, workspace);
+        }
+      );
+
+      return g;
     }
 
+    template <typename Topology>
     void
-    generate(Maze& m) {
-      // The algorithm is taken from here:
-      // https://en.wikipedia.org/wiki/Maze_generation_algorithm#Randomized_Prim's_algorithm
+    generate(Maze& m, std::uint64_t seed) {
+      Stepper<Topology> g(m, seed);
+      g.run();
+    }
 
-      // We start with a grid full of walls.
-      m.close();
+  }
 
-      Walls walls;
-      std::unordered_set<std::string> visited;
+  namespace depthfirst {
 
-      // Convenience lambda to generate the neihbors.
-      auto generateNeighbors = [&m, &visited, &walls](unsigned x, unsigned y) {
-        Opening o(x, y, m.sides(), m.inverted(x, y));
-        m.prepareOpening(o);
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      topology::dispatch(m.sides(),
+        [&m, seed](auto t) {
+          generate<decltype(t)>(m, seed);
+        }
+      );
+    }
 
-        for (unsigned d = 0u ; d < m.sides() ; ++d) {
-          if (!o.canBeOpened(d)) {
-            continue;
+    /// @brief - The generation with the depth-first algorithm
+    /// performed in several steps.
+    template <typename Topology>
+    class Stepper: public Generation {
+      public:
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         */
+        Stepper(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_rng(seed),
+          m_toVisit(this->workspace().allocate<unsigned>(m.width() * m.height())),
+          m_depth(0u),
+          m_visited(this->workspace().cells(m.width() * m.height()))
+        {
+          // We start with a grid full of walls.
+          m.close();
+
+          // Select a random starting cell. The stack can't be
+          // deeper than the number of cells in the maze.
+          unsigned id = m_rng.bounded(m.width() * m.height());
+
+          m_toVisit[m_depth] = id;
+          ++m_depth;
+          m_visited.set(id);
+          ++m_cellsVisited;
+        }
+
+      protected:
+
+        bool
+        advance(unsigned budget) override {
+          // The algorithm is taken from here:
+          // https://en.wikipedia.org/wiki/Maze_generation_algorithm#Iterative_implementation
+          unsigned w = m_maze.width();
+          const Adjacency& adj = m_maze.adjacency();
+
+          // While there are cells to explore, continue.
+          for ( ; m_depth > 0u && budget > 0u ; --budget) {
+            // Visit the current cell: it stays on the stack as
+            // long as it has unvisited neighbors.
+            unsigned id = m_toVisit[m_depth - 1u];
+            const unsigned* cells = adj[id];
+
+            // Generate the unvisited neighbors of this cell, as a
+            // mask of the doors leading to them.
+            unsigned neighbors = 0u;
+
+            for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+              // Prevent cells to be generated if they are out of
+              // the maze or if they already exist.
+              if (cells[d] != Adjacency::BORDER && !m_visited[cells[d]]) {
+                neighbors |= (1u << d);
+              }
+            }
+
+            // In case no neighbors are available, this cell is
+            // done with and we backtrack.
+            if (neighbors == 0u) {
+              --m_depth;
+              continue;
+            }
+
+            // Pick a random neighbor, open the door between it and
+            // the current cell, and then push it on top of the stack.
+            unsigned d = bits::select(neighbors, m_rng.bounded(bits::count(neighbors)));
+
+            unsigned id2 = cells[d];
+            m_maze.m_walls.set(m_maze.template wall<Topology>(id % w, id / w, d, id2));
+            ++m_wallsOpened;
+
+            m_visited.set(id2);
+            ++m_cellsVisited;
+            m_toVisit[m_depth] = id2;
+            ++m_depth;
           }
 
-          unsigned id = m.idFromDoorAndCell(x, y, d);
-          unsigned xn = id % m.width();
-          unsigned yn = id / m.width();
+          return m_depth == 0u;
+        }
 
-          // Prevent cells to be generated if they already exist.
-          if (visited.count(hash(xn, yn)) > 0) {
-            continue;
+      private:
+
+        /**
+         * @brief - The random generator used to pick the cells.
+         */
+        Random m_rng;
+
+        /**
+         * @brief - The stack of cells to visit, allocated from the
+         *          workspace.
+         */
+        unsigned* m_toVisit;
+
+        /**
+         * @brief - The number of cells in the stack.
+         */
+        unsigned m_depth;
+
+        /**
+         * @brief - The cells already visited.
+         */
+        Bitset& m_visited;
+    };
+
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace) {
+      std::unique_ptr<Generation> g;
+      topology::dispatch(m.sides(),
+        [&m, seed, workspace, &g](auto t) {
+          g = std::make_unique<Stepper<decltype(t)>>(m, seed, workspace);
+        }
+      );
+
+      return g;
+    }
+
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      Stepper<Topology> g(m, seed);
+      g.run();
+    }
+
+  }
+
+  namespace wilson {
+
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      topology::dispatch(m.sides(),
+        [&m, seed](auto t) {
+          generate<decltype(t)>(m, seed);
+        }
+      );
+    }
+
+    /// @brief - The generation with Wilson's algorithm performed in
+    /// several steps. The walks can also connect the cells of a maze
+    /// to an existing tree (see `connect`).
+    template <typename Topology>
+    class Stepper: public Generation {
+      public:
+
+        /// @brief - The state of the walks between two steps.
+        struct Walk {
+          // The cell starting the current walk.
+          unsigned start;
+
+          // The current cell of the walk or of the path added to
+          // the tree.
+          unsigned id;
+
+          // Whether the walk is in progress, or the path is being
+          // added to the tree.
+          bool walking;
+        };
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         */
+        Stepper(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_rng(seed),
+          m_inTree(this->workspace().cells(m.width() * m.height())),
+          m_next(this->workspace().allocate<std::uint8_t>(m.width() * m.height())),
+          m_walk{0u, 0u, true}
+        {
+          // A walk never ends if it can't reach the tree.
+          if (!m.adjacency().connected()) {
+            m.error(
+              "Maze with dimensions " + std::to_string(m.width()) + "x" + std::to_string(m.height()) +
+              " is not connected, can't generate it"
+            );
           }
 
-          walls.push_back(Wall{x, y, xn, yn, d});
+          // We start with a grid full of walls.
+          m.close();
+
+          // The tree starts with a random cell.
+          m_inTree.set(m_rng.bounded(m_inTree.size()));
+          ++m_cellsVisited;
         }
-      };
 
-      // Pick a random cell and initialize the list of walls.
-      unsigned size = m.width() * m.height();
+        /**
+         * @brief - Connect the cells of the maze not yet in the tree
+         *          to it with loop-erased random walks, opening the
+         *          walls along the paths. The walks start from the
+         *          cells in increasing order.
+         * @param m - the maze to generate.
+         * @param rng - the random generator to use for the walks.
+         * @param inTree - the cells already in the tree. The tree
+         *                 should not be empty.
+         * @param next - a buffer with a byte per cell used for the
+         *               walks.
+         * @param walk - the state of the walks, initially starting
+         *               from the first cell and walking.
+         * @param budget - the number of cells to process.
+         * @param added - output argument incremented by the number
+         *                of cells added to the tree, which is also
+         *                the number of walls opened.
+         * @return - `true` once all the cells are in the tree.
+         */
+        static
+        bool
+        connect(Maze& m,
+                Random& rng,
+                Bitset& inTree,
+                std::uint8_t* next,
+                Walk& walk,
+                unsigned budget,
+                unsigned& added)
+        {
+          // The algorithm is taken from here:
+          // https://en.wikipedia.org/wiki/Maze_generation_algorithm#Wilson's_algorithm
+          unsigned w = m.width();
+          unsigned size = inTree.size();
+          const Adjacency& adj = m.adjacency();
+
+          while (walk.start < size && budget > 0u) {
+            // Once the walk reaches the tree, the path is added to
+            // it from the start of the walk. Once it is added, the
+            // next cell starts a new walk.
+            if (inTree[walk.id]) {
+              if (walk.walking) {
+                walk.walking = false;
+              }
+              else {
+                ++walk.start;
+                walk.walking = true;
+              }
+
+              walk.id = walk.start;
+              continue;
+            }
+
+            --budget;
+            const unsigned* cells = adj[walk.id];
+
+            if (!walk.walking) {
+              // Add the loop-erased path to the tree, opening the
+              // walls along the way.
+              unsigned d = next[walk.id];
+              unsigned id2 = cells[d];
+
+              inTree.set(walk.id);
+              m.m_walls.set(m.template wall<Topology>(walk.id % w, walk.id / w, d, id2));
+              ++added;
+
+              walk.id = id2;
+              continue;
+            }
+
+            // Only interior cells have all their doors leading
+            // to a neighbor: picking a random door and trying
+            // again when it leads outside keeps the choice
+            // uniform without computing the valid ones. As the
+            // maze is connected, each cell has a neighbor.
+            unsigned d = rng.bounded(Topology::SIDES);
+            while (cells[d] == Adjacency::BORDER) {
+              d = rng.bounded(Topology::SIDES);
+            }
+
+            next[walk.id] = static_cast<std::uint8_t>(d);
+            walk.id = cells[d];
+          }
+
+          return walk.start >= size;
+        }
 
-      unsigned id = std::rand() % size;
-      unsigned x1 = id % m.width();
-      unsigned y1 = id / m.width();
+      protected:
 
-      generateNeighbors(x1, y1);
-      visited.insert(hash(x1, y1));
+        bool
+        advance(unsigned budget) override {
+          unsigned added = 0u;
+          bool done = connect(m_maze, m_rng, m_inTree, m_next, m_walk, budget, added);
 
-      // Continue processing while there are walls to analyze.
-      while (!walls.empty()) {
-        // Pick a random wall.
-        Wall w = walls.pick();
+          m_cellsVisited += added;
+          m_wallsOpened += added;
 
-        // Check whether the destination cell is visited.
-        if (visited.count(hash(w.xE, w.yE)) > 0) {
-          continue;
+          return done;
         }
 
-        visited.insert(hash(w.xE, w.yE));
+      private:
+
+        /**
+         * @brief - The random generator used for the walks.
+         */
+        Random m_rng;
+
+        /**
+         * @brief - The cells already in the tree.
+         */
+        Bitset& m_inTree;
+
+        /**
+         * @brief - The walk does not keep the list of cells it went
+         *          through: instead each cell remembers the door
+         *          used the last time the walk left it. Following
+         *          these doors from the start of the walk yields the
+         *          path with all its loops erased, as a loop is
+         *          overridden whenever the walk leaves a cell again.
+         */
+        std::uint8_t* m_next;
+
+        /**
+         * @brief - The state of the walks.
+         */
+        Walk m_walk;
+    };
+
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace) {
+      std::unique_ptr<Generation> g;
+      topology::dispatch(m.sides(),
+        [&m, seed, workspace, &g](auto t) {
+          g = std::make_unique<Stepper<decltype(t)>>(m, seed, workspace);
+        }
+      );
 
-        // Open the wall for both cells.
-        bool inv1 = m.inverted(w.xO, w.yO);
-        m.m_cells[m.linear(w.xO, w.yO)].toggle(w.door, true);
-        m.m_cells[m.linear(w.xE, w.yE)].toggle(m.opposite(w.door, inv1), true);
+      return g;
+    }
 
-        // Generate the neighbors of the cell.
-        generateNeighbors(w.xE, w.yE);
-      }
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      Stepper<Topology> g(m, seed);
+      g.run();
     }
 
   }
 
-  namespace depthfirst {
+  namespace aldousbroder {
+
+    void
+    generate(Maze& m, std::uint64_t seed, float fraction) {
+      topology::dispatch(m.sides(),
+        [&m, seed, fraction](auto t) {
+          generate<decltype(t)>(m, seed, fraction);
+        }
+      );
+    }
+
+    /// @brief - The generation with the Aldous-Broder algorithm
+    /// performed in several steps.
+    template <typename Topology>
+    class Stepper: public Generation {
+      public:
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         * @param fraction - the fraction of the cells to visit with
+         *                   the random walk.
+         */
+        Stepper(Maze& m, std::uint64_t seed, float fraction, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_rng(seed),
+          m_visited(this->workspace().cells(m.width() * m.height())),
+
+          m_target(0u),
+          m_count(0u),
+          m_id(0u),
+
+          m_next(this->workspace().allocate<std::uint8_t>(m.width() * m.height())),
+          m_walk{0u, 0u, true}
+        {
+          // The walks never end if some cells can't be reached.
+          if (!m.adjacency().connected()) {
+            m.error(
+              "Maze with dimensions " + std::to_string(m.width()) + "x" + std::to_string(m.height()) +
+              " is not connected, can't generate it"
+            );
+          }
+
+          // We start with a grid full of walls.
+          m.close();
+
+          // Compute the number of cells to visit with the random
+          // walk: the walk rarely finds new cells when most of the
+          // maze is visited, so the rest is left to Wilson's walks
+          // which only get faster as the maze grows.
+          unsigned size = m_visited.size();
+          fraction = std::min(std::max(fraction, 0.0f), 1.0f);
+          m_target = std::max(1u, static_cast<unsigned>(fraction * size));
+
+          m_id = m_rng.bounded(size);
+          m_visited.set(m_id);
+          m_count = 1u;
+
+          m_cellsVisited = m_count;
+        }
+
+      protected:
+
+        bool
+        advance(unsigned budget) override {
+          // The algorithm is taken from here:
+          // https://en.wikipedia.org/wiki/Maze_generation_algorithm#Aldous-Broder_algorithm
+          unsigned w = m_maze.width();
+          const Adjacency& adj = m_maze.adjacency();
+
+          for ( ; m_count < m_target && budget > 0u ; --budget) {
+            const unsigned* cells = adj[m_id];
+
+            // Move to a random neighbor, see the `wilson` namespace
+            // for how doors leading outside are handled.
+            unsigned d = m_rng.bounded(Topology::SIDES);
+            while (cells[d] == Adjacency::BORDER) {
+              d = m_rng.bounded(Topology::SIDES);
+            }
 
-    /// @brief - Convenience structure describing a cell.
-    struct Cell {
-      // The x coordinate of the cell.
-      unsigned x;
+            unsigned id2 = cells[d];
 
-      // The y coordinate of the cell.
-      unsigned y;
+            // Open the wall when entering a cell for the first time.
+            if (!m_visited[id2]) {
+              m_maze.m_walls.set(m_maze.template wall<Topology>(m_id % w, m_id / w, d, id2));
+              m_visited.set(id2);
+              ++m_count;
+
+              m_cellsVisited = m_count;
+              ++m_wallsOpened;
+            }
+
+            m_id = id2;
+          }
+
+          if (m_count < m_target) {
+            return false;
+          }
+
+          // Connect the remaining cells with loop-erased walks: the
+          // visited cells form the initial tree.
+          unsigned added = 0u;
+          bool done = wilson::Stepper<Topology>::connect(m_maze, m_rng, m_visited, m_next, m_walk, budget, added);
+
+          m_cellsVisited += added;
+          m_wallsOpened += added;
+
+          return done;
+        }
+
+      private:
+
+        /**
+         * @brief - The random generator used for the walk.
+         */
+        Random m_rng;
+
+        /**
+         * @brief - The cells already visited by the walk.
+         */
+        Bitset& m_visited;
+
+        /**
+         * @brief - The number of cells to visit with the walk.
+         */
+        unsigned m_target;
+
+        /**
+         * @brief - The number of cells visited by the walk.
+         */
+        unsigned m_count;
+
+        /**
+         * @brief - The current cell of the walk.
+         */
+        unsigned m_id;
+
+        /**
+         * @brief - The buffer used by the walks connecting the
+         *          remaining cells (see `wilson::Stepper`).
+         */
+        std::uint8_t* m_next;
+
+        /**
+         * @brief - The state of the walks connecting the remaining
+         *          cells, once the random walk is over.
+         */
+        typename wilson::Stepper<Topology>::Walk m_walk;
     };
 
-    std::string
-    hash(unsigned x, unsigned y) noexcept {
-      return std::to_string(x) + "x" + std::to_string(y);
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, float fraction, Workspace* workspace) {
+      std::unique_ptr<Generation> g;
+      topology::dispatch(m.sides(),
+        [&m, seed, fraction, workspace, &g](auto t) {
+          g = std::make_unique<Stepper<decltype(t)>>(m, seed, fraction, workspace);
+        }
+      );
+
+      return g;
     }
 
+    template <typename Topology>
     void
-    generate(Maze& m) {
-      // The algorithm is taken from here:
-      // https://en.wikipedia.org/wiki/Maze_generation_algorithm#Iterative_implementation
-      unsigned size = m.width() * m.height();
+    generate(Maze& m, std::uint64_t seed, float fraction) {
+      Stepper<Topology> g(m, seed, fraction);
+      g.run();
+    }
 
-      // We start with a grid full of walls.
-      m.close();
+  }
 
-      // Generate the list of cells to visit.
-      std::stack<Cell> toVisit;
-      std::unordered_set<std::string> visited;
+  namespace eller {
+
+    /// @brief - The generation with Eller's algorithm performed in
+    /// several steps: each step copies some rows in the maze.
+    class Stepper: public Generation {
+      public:
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         * @param workspace - the buffers used to produce the rows.
+         */
+        Stepper(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_rows(m.width(), m.height(), m.sides(), seed, &this->workspace())
+        {
+          // We start with a grid full of walls.
+          m.close();
+        }
+
+      protected:
 
-      // Select a random starting cell.
-      unsigned id = std::rand() % size;
-      unsigned x = id % m.width();
-      unsigned y = id / m.width();
+        bool
+        advance(unsigned budget) override {
+          // Copy each row in the maze as it is produced.
+          while (budget > 0u) {
+            if (!m_rows.next()) {
+              return true;
+            }
 
-      toVisit.push(Cell{x, y});
+            unsigned y = m_rows.row();
 
-      // While there are cells to explore, continue.
-      while (!toVisit.empty()) {
-        // Visit the current cell.
-        Cell c = toVisit.top();
-        toVisit.pop();
+            for (unsigned slot = 0u ; slot < m_rows.slots() ; ++slot) {
+              for (unsigned x = 0u ; x < m_rows.width() ; ++x) {
+                if (m_rows.open(x, slot)) {
+                  m_maze.m_walls.set(m_maze.slotIndex(x, y, slot));
+                  ++m_wallsOpened;
+                }
+              }
+            }
 
-        visited.insert(hash(c.x, c.y));
+            m_cellsVisited += m_rows.width();
+            budget -= std::min(budget, m_rows.width());
+          }
 
-        // Generate the unvisited neighbors of this cell.
-        Opening o(c.x, c.y, m.sides(), m.inverted(c.x, c.y));
-        m.prepareOpening(o);
+          return false;
+        }
 
-        std::vector<unsigned> neighbors;
+      private:
 
-        for (unsigned d = 0u ; d < m.sides() ; ++d) {
-          if (!o.canBeOpened(d)) {
-            continue;
-          }
+        /**
+         * @brief - The generator producing the rows.
+         */
+        RowGenerator m_rows;
+    };
 
-          id = m.idFromDoorAndCell(c.x, c.y, d);
-          x = id % m.width();
-          y = id / m.width();
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace) {
+      return std::make_unique<Stepper>(m, seed, workspace);
+    }
 
-          // Prevent cells to be generated if they already exist.
-          if (visited.count(hash(x, y)) > 0) {
-            continue;
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      Stepper g(m, seed);
+      g.run();
+    }
+
+  }
+
+  namespace binarytree {
+
+    /// @brief - The generation with the binary tree algorithm
+    /// performed in several steps: each step processes some rows.
+    class Stepper: public Generation {
+      public:
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         */
+        Stepper(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_rng(seed),
+          m_row(0u)
+        {
+          if (m.sides() != topology::Square::SIDES) {
+            m.warn(
+              "Failed to generate maze",
+              "Binary tree only supports square cells, not " + std::to_string(m.sides()) + " side(s)"
+            );
+
+            m_row = m.height();
+            return;
           }
 
-          neighbors.push_back(d);
+          // We start with a grid full of walls.
+          m.close();
         }
 
-        // In case no neighbors are available, stop the progress.
-        if (neighbors.empty()) {
-          continue;
+      protected:
+
+        bool
+        advance(unsigned budget) override {
+          // The algorithm is taken from here:
+          // https://weblog.jamisbuck.org/2011/2/1/maze-generation-binary-tree-algorithm
+          unsigned w = m_maze.width();
+          unsigned h = m_maze.height();
+          unsigned words = (w + Bitset::WORD_BITS - 1u) / Bitset::WORD_BITS;
+
+          // The rows of the walls start on a word boundary: each
+          // bit of a random word decides whether the corresponding
+          // cell opens its right (square's slot 0) or its top door
+          // (square's slot 1). The last cell of a row can only go
+          // up and the top row can only go right.
+          for ( ; m_row < h && budget > 0u ; ++m_row) {
+            unsigned right = m_maze.slotIndex(0u, m_row, 0u) / Bitset::WORD_BITS;
+            unsigned up = m_maze.slotIndex(0u, m_row, 1u) / Bitset::WORD_BITS;
+            bool top = (m_row + 1u == h);
+
+            for (unsigned k = 0u ; k < words ; ++k) {
+              Bitset::Word valid = ~Bitset::Word(0u);
+              Bitset::Word last = 0u;
+
+              if (k + 1u == words) {
+                unsigned end = (w - 1u) % Bitset::WORD_BITS;
+                last = Bitset::Word(1u) << end;
+                valid = last | (last - 1u);
+              }
+
+              Bitset::Word r = (top ? ~Bitset::Word(0u) : m_rng.next());
+
+              m_maze.m_walls.setWord(right + k, r & valid & ~last);
+              if (!top) {
+                m_maze.m_walls.setWord(up + k, (~r & valid) | last);
+              }
+            }
+
+            // Each cell opens a single wall, except the last one
+            // of the top row.
+            m_cellsVisited += w;
+            m_wallsOpened += (top ? w - 1u : w);
+
+            budget -= std::min(budget, w);
+          }
+
+          return m_row >= h;
         }
 
-        // Otherwise, push back the cell on the stack.
-        toVisit.push(c);
+      private:
 
-        // Pick a random neighbor, open the door between it and
-        // the current cell, and then push it on top of the stack.
-        unsigned d = neighbors[std::rand() % neighbors.size()];
+        /**
+         * @brief - The random generator deciding the doors.
+         */
+        Random m_rng;
 
-        id = m.linear(c.x, c.y);
-        unsigned id2 = m.idFromDoorAndCell(c.x, c.y, d);
-        m.m_cells[id].toggle(d, true);
-        m.m_cells[id2].toggle(m.opposite(d, m.inverted(c.x, c.y)), true);
+        /**
+         * @brief - The next row to process.
+         */
+        unsigned m_row;
+    };
+
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace) {
+      return std::make_unique<Stepper>(m, seed, workspace);
+    }
 
-        toVisit.push(Cell{id2 % m.width(), id2 / m.width()});
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      Stepper g(m, seed);
+      g.run();
+    }
+
+  }
+
+  namespace sidewinder {
+
+    /// @brief - The generation with the sidewinder algorithm
+    /// performed in several steps: each step processes some rows.
+    class Stepper: public Generation {
+      public:
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         */
+        Stepper(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_rng(seed),
+          m_row(0u)
+        {
+          if (m.sides() != topology::Square::SIDES) {
+            m.warn(
+              "Failed to generate maze",
+              "Sidewinder only supports square cells, not " + std::to_string(m.sides()) + " side(s)"
+            );
+
+            m_row = m.height();
+            return;
+          }
+
+          // We start with a grid full of walls.
+          m.close();
+        }
+
+      protected:
+
+        bool
+        advance(unsigned budget) override {
+          // The algorithm is taken from here:
+          // https://weblog.jamisbuck.org/2011/2/3/maze-generation-sidewinder-algorithm
+          unsigned w = m_maze.width();
+          unsigned h = m_maze.height();
+          unsigned words = (w + Bitset::WORD_BITS - 1u) / Bitset::WORD_BITS;
+
+          for ( ; m_row < h && budget > 0u ; ++m_row) {
+            unsigned right = m_maze.slotIndex(0u, m_row, 0u) / Bitset::WORD_BITS;
+            unsigned up = m_maze.slotIndex(0u, m_row, 1u) / Bitset::WORD_BITS;
+            bool top = (m_row + 1u == h);
+
+            // The first cell of the current run.
+            unsigned start = 0u;
+
+            for (unsigned k = 0u ; k < words ; ++k) {
+              Bitset::Word valid = ~Bitset::Word(0u);
+              Bitset::Word last = 0u;
+
+              if (k + 1u == words) {
+                unsigned end = (w - 1u) % Bitset::WORD_BITS;
+                last = Bitset::Word(1u) << end;
+                valid = last | (last - 1u);
+              }
+
+              // Each bit of a random word decides whether the cell
+              // extends the run to its right (square's slot 0). The
+              // top row is a single run.
+              Bitset::Word r = (top ? ~Bitset::Word(0u) : m_rng.next());
+              Bitset::Word east = r & valid & ~last;
+
+              m_maze.m_walls.setWord(right + k, east);
+              if (top) {
+                continue;
+              }
+
+              // The other cells close their run: one random cell of
+              // the run opens its top door (square's slot 1). Runs
+              // may start in a previous word.
+              Bitset::Word ends = ~east & valid;
+              Bitset::Word doors = 0u;
+
+              while (ends != 0u) {
+                unsigned x = k * Bitset::WORD_BITS + bits::select(ends, 0u);
+                ends &= ends - 1u;
+
+                unsigned c = start + m_rng.bounded(x - start + 1u);
+                if (c / Bitset::WORD_BITS == k) {
+                  doors |= Bitset::Word(1u) << (c % Bitset::WORD_BITS);
+                }
+                else {
+                  m_maze.m_walls.set(m_maze.slotIndex(c, m_row, 1u));
+                }
+
+                start = x + 1u;
+              }
+
+              m_maze.m_walls.setWord(up + k, m_maze.m_walls.word(up + k) | doors);
+            }
+
+            // Each cell opens a single wall, except the last one
+            // of the top row.
+            m_cellsVisited += w;
+            m_wallsOpened += (top ? w - 1u : w);
+
+            budget -= std::min(budget, w);
+          }
+
+          return m_row >= h;
+        }
+
+      private:
+
+        /**
+         * @brief - The random generator deciding the runs.
+         */
+        Random m_rng;
+
+        /**
+         * @brief - The next row to process.
+         */
+        unsigned m_row;
+    };
+
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace) {
+      return std::make_unique<Stepper>(m, seed, workspace);
+    }
+
+    void
+    generate(Maze& m, std::uint64_t seed) {
+      Stepper g(m, seed);
+      g.run();
+    }
+
+  }
+
+  namespace tiles {
+
+    /// @brief - Convenience structure defining a wall between two
+    /// tiles of the maze.
+    struct Boundary {
+      // The index of the tile holding the wall.
+      unsigned tile;
+
+      // The index of the tile on the other side.
+      unsigned other;
+
+      // The index of the wall in the walls of the maze.
+      unsigned wall;
+    };
+
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, unsigned size, Context* context) {
+      topology::dispatch(m.sides(),
+        [&m, seed, &pool, size, context](auto t) {
+          generate<decltype(t)>(m, seed, pool, size, context);
+        }
+      );
+    }
+
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, unsigned size, Context* context) {
+      unsigned w = m.width();
+      unsigned h = m.height();
+
+      // Tiles spanning a whole number of words do not share any
+      // word of the walls so they can be copied concurrently. It
+      // also guarantees that the tiles start at even coordinates
+      // which preserves the orientation of the triangles and the
+      // offsets of the columns of hexagons.
+      size = std::max(size, 1u);
+      size = ((size + Bitset::WORD_BITS - 1u) / Bitset::WORD_BITS) * Bitset::WORD_BITS;
+
+      unsigned cols = std::max(1u, w / size);
+      unsigned rows = std::max(1u, h / size);
+      unsigned count = cols * rows;
+
+      auto tileOf = [size, cols, rows](unsigned x, unsigned y) {
+        return std::min(y / size, rows - 1u) * cols + std::min(x / size, cols - 1u);
+      };
+
+      // We start with a grid full of walls.
+      m.close();
+
+      // Generate each tile in a maze of its own and copy its walls
+      // in the maze: walls leading outside of the tile are never
+      // opened by the generation.
+      pool.run(count,
+        [&m, seed, size, cols, rows, w, h, context](unsigned id, unsigned /*thread*/) {
+          // The tiles left are skipped in case the generation is
+          // cancelled.
+          if (context != nullptr && context->cancelled()) {
+            return;
+          }
+
+          unsigned tx = id % cols;
+          unsigned ty = id / cols;
+          unsigned ox = tx * size;
+          unsigned oy = ty * size;
+          unsigned tw = (tx + 1u == cols ? w : ox + size) - ox;
+          unsigned th = (ty + 1u == rows ? h : oy + size) - oy;
+
+          MazeShPtr tile = Maze::create(tw, th, m.m_strategy, Topology::SIDES);
+          tile->setPolicy(m.m_policy);
+          tile->generate(Random::mix(seed, id));
+
+          unsigned words = tile->m_stride / Bitset::WORD_BITS;
+
+          for (unsigned slot = 0u ; slot < Topology::SLOTS ; ++slot) {
+            for (unsigned y = 0u ; y < th ; ++y) {
+              unsigned from = tile->slotIndex(0u, y, slot) / Bitset::WORD_BITS;
+              unsigned to = m.slotIndex(ox, oy + y, slot) / Bitset::WORD_BITS;
+
+              for (unsigned k = 0u ; k < words ; ++k) {
+                m.m_walls.setWord(to + k, tile->m_walls.word(from + k));
+              }
+            }
+          }
+
+          // Each tile is a perfect maze on its own.
+          if (context != nullptr) {
+            context->accumulate(tw * th, tw * th - 1u, 1.0f * tw * th / (w * h));
+          }
+        }
+      );
+
+      if (count == 1u || (context != nullptr && context->cancelled())) {
+        return;
+      }
+
+      // Gather the walls between two tiles: they are owned by the
+      // cells on the border of the tiles.
+      std::vector<Boundary> walls;
+
+      auto gather = [&m, &walls, &tileOf, w, h](unsigned id, unsigned x, unsigned y) {
+        bool inv = Topology::inverted(x, y);
+        unsigned closed = Topology::closed(x, y, w, h);
+
+        unsigned slot = 0u;
+        for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+          if (((closed >> d) & 1u) || !Topology::owns(d, inv, slot)) {
+            continue;
+          }
+
+          unsigned n = Topology::neighbor(x, y, w, d);
+          unsigned other = tileOf(n % w, n / w);
+
+          if (other != id) {
+            walls.push_back(Boundary{id, other, m.slotIndex(x, y, slot)});
+          }
+        }
+      };
+
+      for (unsigned id = 0u ; id < count ; ++id) {
+        unsigned tx = id % cols;
+        unsigned ty = id / cols;
+        unsigned ox = tx * size;
+        unsigned oy = ty * size;
+        unsigned ex = (tx + 1u == cols ? w : ox + size) - 1u;
+        unsigned ey = (ty + 1u == rows ? h : oy + size) - 1u;
+
+        for (unsigned x = ox ; x <= ex ; ++x) {
+          gather(id, x, oy);
+          if (ey != oy) {
+            gather(id, x, ey);
+          }
+        }
+
+        for (unsigned y = oy + 1u ; y < ey ; ++y) {
+          gather(id, ox, y);
+          if (ex != ox) {
+            gather(id, ex, y);
+          }
+        }
+      }
+
+      // Connect the tiles with a random spanning tree of these
+      // walls, as in the Kruskal's algorithm.
+      Random rng(seed);
+      rng.shuffle(walls.begin(), walls.end());
+
+      UnionFind regions(count);
+
+      for (unsigned id = 0u ; id < walls.size() && regions.sets() > 1u ; ++id) {
+        if (regions.merge(walls[id].tile, walls[id].other)) {
+          m.m_walls.set(walls[id].wall);
+        }
+      }
+    }
+
+  }
+
+  namespace boruvka {
+
+    /// @brief - The number of cells processed by each task.
+    constexpr unsigned GRAIN = 4096u;
+
+    /// @brief - Marker for a region which did not find any wall
+    /// leading outside of it.
+    constexpr std::uint64_t NONE = ~std::uint64_t(0u);
+
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context) {
+      topology::dispatch(m.sides(),
+        [&m, seed, &pool, context](auto t) {
+          generate<decltype(t)>(m, seed, pool, context);
+        }
+      );
+    }
+
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context) {
+      // The algorithm is taken from here:
+      // https://en.wikipedia.org/wiki/Bor%C5%AFvka%27s_algorithm
+      unsigned w = m.width();
+      unsigned size = w * m.height();
+      const Adjacency& adj = m.adjacency();
+
+      // The weights below are only unique (and different from
+      // `NONE`) if the identifiers of the walls fit in 32 bits.
+      if (std::uint64_t(size) * Topology::SIDES >= 0xFFFFFFFFull) {
+        m.error(
+          "Maze with dimensions " + std::to_string(w) + "x" + std::to_string(m.height()) +
+          " has too many walls to be generated with Boruvka's algorithm"
+        );
+      }
+
+      // We start with a grid full of walls.
+      m.close();
+
+      // Each wall is identified by the cell owning it and the
+      // door leading to it. Its weight is a hash of the seed
+      // and of this identifier: the weight is stored in the
+      // high 32 bits and the identifier in the low 32 bits so
+      // that all weights are different.
+      auto weight = [seed](unsigned cell, unsigned door) {
+        std::uint64_t wall = std::uint64_t(cell) * Topology::SIDES + door;
+        return ((Random::mix(seed, wall) >> 32u) << 32u) | std::uint32_t(wall);
+      };
+
+      ConcurrentUnionFind regions(size);
+      std::unique_ptr<std::atomic<std::uint64_t>[]> best(new std::atomic<std::uint64_t>[size]);
+      for (unsigned id = 0u ; id < size ; ++id) {
+        best[id].store(NONE, std::memory_order_relaxed);
+      }
+
+      // The cells which may still have a neighbor in another
+      // region, along with their region for the current round.
+      // Regions only grow: a cell without such neighbor is
+      // done with.
+      std::vector<unsigned> active(size);
+      std::vector<unsigned> roots(size);
+      std::vector<unsigned> kept;
+
+      for (unsigned id = 0u ; id < size ; ++id) {
+        active[id] = id;
+      }
+
+      auto interrupted = [context]() {
+        return context != nullptr && context->cancelled();
+      };
+
+      while (!active.empty() && !interrupted()) {
+        unsigned count = static_cast<unsigned>(active.size());
+        unsigned tasks = (count + GRAIN - 1u) / GRAIN;
+        kept.assign(tasks, 0u);
+
+        // Each region picks the lightest wall leading outside of
+        // it. The cells still active are packed at the beginning
+        // of the range of their task.
+        pool.run(tasks,
+          [&](unsigned task, unsigned /*thread*/) {
+            if (interrupted()) {
+              return;
+            }
+
+            unsigned begin = task * GRAIN;
+            unsigned end = std::min(count, begin + GRAIN);
+            unsigned out = begin;
+
+            for (unsigned id = begin ; id < end ; ++id) {
+              unsigned cell = active[id];
+              unsigned root = regions.find(cell);
+              const unsigned* cells = adj[cell];
+              bool inv = Topology::inverted(cell % w, cell / w);
+
+              std::uint64_t lightest = NONE;
+
+              for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+                unsigned other = cells[d];
+                if (other == Adjacency::BORDER || regions.find(other) == root) {
+                  continue;
+                }
+
+                // Identify the wall from the cell owning it.
+                unsigned slot = 0u;
+                std::uint64_t key = (
+                  Topology::owns(d, inv, slot) ?
+                  weight(cell, d) :
+                  weight(other, Topology::opposite(d, inv))
+                );
+
+                lightest = std::min(lightest, key);
+              }
+
+              if (lightest == NONE) {
+                continue;
+              }
+
+              std::uint64_t prev = best[root].load(std::memory_order_relaxed);
+              while (lightest < prev &&
+                     !best[root].compare_exchange_weak(prev, lightest, std::memory_order_relaxed))
+              {}
+
+              active[out] = cell;
+              roots[out] = root;
+              ++out;
+            }
+
+            kept[task] = out - begin;
+
+            // The cells left behind are done with.
+            if (context != nullptr) {
+              context->accumulate(end - out, 0u, 0.0f);
+            }
+          }
+        );
+
+        // Some regions may not have picked their wall.
+        if (interrupted()) {
+          return;
+        }
+
+        // Open the wall picked by each region. As all weights are
+        // different these walls never form a cycle: merging only
+        // fails when two regions picked the same wall.
+        pool.run(tasks,
+          [&](unsigned task, unsigned /*thread*/) {
+            unsigned begin = task * GRAIN;
+            unsigned end = begin + kept[task];
+            unsigned opened = 0u;
+
+            for (unsigned id = begin ; id < end ; ++id) {
+              std::uint64_t key = best[roots[id]].exchange(NONE, std::memory_order_relaxed);
+              if (key == NONE) {
+                continue;
+              }
+
+              unsigned wall = static_cast<unsigned>(key & 0xFFFFFFFFull);
+              unsigned cell = wall / Topology::SIDES;
+              unsigned d = wall % Topology::SIDES;
+              unsigned other = adj[cell][d];
+
+              if (regions.merge(cell, other)) {
+                m.m_walls.setConcurrently(m.template wall<Topology>(cell % w, cell / w, d, other));
+                ++opened;
+              }
+            }
+
+            if (context != nullptr && opened > 0u) {
+              context->accumulate(0u, opened, 1.0f * opened / (size - 1u));
+            }
+          }
+        );
+
+        // Pack the active cells for the next round.
+        unsigned packed = 0u;
+        for (unsigned task = 0u ; task < tasks ; ++task) {
+          unsigned begin = task * GRAIN;
+
+          for (unsigned id = begin ; id < begin + kept[task] ; ++id) {
+            active[packed] = active[id];
+            ++packed;
+          }
+        }
+
+        active.resize(packed);
+      }
+    }
+
+  }
+
+  namespace recursivedivision {
+
+    /// @brief - A rectangular chamber of the maze: it contains the
+    /// cells in the range `[x0; x1[` and `[y0; y1[`.
+    struct Chamber {
+      unsigned x0;
+      unsigned y0;
+      unsigned x1;
+      unsigned y1;
+    };
+
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, unsigned cutoff, Context* context) {
+      topology::dispatch(m.sides(),
+        [&m, seed, &pool, cutoff, context](auto t) {
+          generate<decltype(t)>(m, seed, pool, cutoff, context);
+        }
+      );
+    }
+
+    /// @brief - The generation with the recursive division algorithm
+    /// performed in several steps: each step divides some chambers.
+    template <typename Topology>
+    class Stepper: public Generation {
+      public:
+
+        /// @brief - A single column of triangles is not connected so
+        /// the chambers are kept at least two cells wide.
+        static constexpr unsigned NARROWEST = (Topology::SIDES == topology::Triangle::SIDES ? 2u : 1u);
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         */
+        Stepper(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_seed(seed),
+          m_chambers(this->workspace().allocate<Chamber>(m.width() + m.height())),
+          m_depth(0u)
+        {
+          // Each division makes both halves narrower or lower than
+          // the chamber: the stack only holds the second halves of
+          // the chambers on the path to the current one so it has
+          // less elements than the sum of the dimensions.
+          if (prepare(m)) {
+            m_chambers[m_depth] = Chamber{0u, 0u, m.width(), m.height()};
+            ++m_depth;
+          }
+        }
+
+        /**
+         * @brief - Implementation of the interface method: the
+         *          progress is the fraction of the cells belonging
+         *          to chambers which can't be divided anymore.
+         * @return - the fraction of the generation completed.
+         */
+        float
+        completion() const noexcept override {
+          unsigned size = m_maze.width() * m_maze.height();
+          return (size == 0u ? 1.0f : 1.0f * m_cellsVisited / size);
+        }
+
+        /**
+         * @brief - Open all the walls of the maze before dividing it.
+         * @param m - the maze to prepare.
+         * @return - `false` if the maze can't be divided.
+         */
+        static
+        bool
+        prepare(Maze& m) {
+          // We start with a grid without any wall.
+          m.open();
+
+          // A chamber no wider than the narrowest one or only one
+          // row high is already a perfect maze.
+          if (m.width() < NARROWEST && m.height() > 1u) {
+            m.warn(
+              "Failed to generate maze",
+              "Maze is too narrow to be divided in chambers"
+            );
+
+            return false;
+          }
+
+          return true;
+        }
+
+        /**
+         * @brief - Divide the chamber in two along a row or a column
+         *          and close all the walls crossing the line but one.
+         *          Chambers may be divided concurrently.
+         * @param m - the maze to divide.
+         * @param adj - the adjacency of the cells of the maze.
+         * @param seed - the seed of the random generator.
+         * @param c - the chamber to divide.
+         * @param first - output argument receiving the first half.
+         * @param second - output argument receiving the second half.
+         * @return - the length of the line dividing the chamber or
+         *           `0` if it can't be divided anymore.
+         */
+        static
+        unsigned
+        divide(Maze& m,
+               const Adjacency& adj,
+               std::uint64_t seed,
+               const Chamber& c,
+               Chamber& first,
+               Chamber& second)
+        {
+          unsigned w = m.width();
+          unsigned cw = c.x1 - c.x0;
+          unsigned ch = c.y1 - c.y0;
+
+          if (ch == 1u || cw <= NARROWEST) {
+            return 0u;
+          }
+
+          // The random generator only depends on the position of
+          // the chamber: the division does not depend on the order
+          // in which the chambers are processed.
+          Random rng(Random::mix(
+            Random::mix(seed, (std::uint64_t(c.y0) << 32u) | c.x0),
+            (std::uint64_t(c.y1) << 32u) | c.x1
+          ));
+
+          // Close the walls owned by the cell and leading to the
+          // input range of cells. One of them is kept as passage
+          // through reservoir sampling.
+          unsigned count = 0u;
+          unsigned passage = 0u;
+
+          auto cross = [&](unsigned x, unsigned y, const Chamber& range) {
+            const unsigned* cells = adj[m.linear(x, y)];
+            bool inv = Topology::inverted(x, y);
+
+            unsigned slot = 0u;
+            for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+              unsigned other = cells[d];
+              if (other == Adjacency::BORDER || !Topology::owns(d, inv, slot)) {
+                continue;
+              }
+
+              unsigned ox = other % w;
+              unsigned oy = other / w;
+              if (ox < range.x0 || ox >= range.x1 || oy < range.y0 || oy >= range.y1) {
+                continue;
+              }
+
+              // Chambers processed at the same time may share words
+              // of the walls.
+              unsigned wall = m.slotIndex(x, y, slot);
+              m.m_walls.unsetConcurrently(wall);
+
+              ++count;
+              if (rng.bounded(count) == 0u) {
+                passage = wall;
+              }
+            }
+          };
+
+          bool vertical = cw >= 2u * NARROWEST && (cw > ch || (cw == ch && rng.bounded(2u) == 0u));
+          unsigned length = 0u;
+
+          if (vertical) {
+            unsigned k = c.x0 + NARROWEST + rng.bounded(cw - 2u * NARROWEST + 1u);
+            first = Chamber{c.x0, c.y0, k, c.y1};
+            second = Chamber{k, c.y0, c.x1, c.y1};
+
+            // The walls between two columns can be owned by cells
+            // of any of them.
+            for (unsigned y = c.y0 ; y < c.y1 ; ++y) {
+              cross(k - 1u, y, Chamber{k, c.y0, k + 1u, c.y1});
+              cross(k, y, Chamber{k - 1u, c.y0, k, c.y1});
+            }
+
+            length = ch;
+          }
+          else {
+            unsigned k = c.y0 + 1u + rng.bounded(ch - 1u);
+            first = Chamber{c.x0, c.y0, c.x1, k};
+            second = Chamber{c.x0, k, c.x1, c.y1};
+
+            // Owned doors never lead down: all the walls between
+            // two rows are owned by the lower one.
+            for (unsigned x = c.x0 ; x < c.x1 ; ++x) {
+              cross(x, k - 1u, Chamber{c.x0, k, c.x1, k + 1u});
+            }
+
+            length = cw;
+          }
+
+          m.m_walls.setConcurrently(passage);
+
+          return length;
+        }
+
+      protected:
+
+        bool
+        advance(unsigned budget) override {
+          // The algorithm is taken from here:
+          // https://en.wikipedia.org/wiki/Maze_generation_algorithm#Recursive_division_method
+          const Adjacency& adj = m_maze.adjacency();
+          Chamber first{}, second{};
+
+          while (m_depth > 0u && budget > 0u) {
+            --m_depth;
+            Chamber c = m_chambers[m_depth];
+
+            unsigned length = divide(m_maze, adj, m_seed, c, first, second);
+            if (length > 0u) {
+              m_chambers[m_depth] = second;
+              m_chambers[m_depth + 1u] = first;
+              m_depth += 2u;
+
+              // A single passage is kept through the line.
+              ++m_wallsOpened;
+            }
+            else {
+              m_cellsVisited += (c.x1 - c.x0) * (c.y1 - c.y0);
+            }
+
+            budget -= std::min(budget, std::max(length, 1u));
+          }
+
+          return m_depth == 0u;
+        }
+
+      private:
+
+        /**
+         * @brief - The seed from which the division of each chamber
+         *          is derived.
+         */
+        std::uint64_t m_seed;
+
+        /**
+         * @brief - The stack of chambers left to divide, allocated
+         *          from the workspace.
+         */
+        Chamber* m_chambers;
+
+        /**
+         * @brief - The number of chambers in the stack.
+         */
+        unsigned m_depth;
+    };
+
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace) {
+      std::unique_ptr<Generation> g;
+      topology::dispatch(m.sides(),
+        [&m, seed, workspace, &g](auto t) {
+          g = std::make_unique<Stepper<decltype(t)>>(m, seed, workspace);
+        }
+      );
+
+      return g;
+    }
+
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, unsigned cutoff, Context* context) {
+      unsigned w = m.width();
+      unsigned h = m.height();
+      const Adjacency& adj = m.adjacency();
+
+      if (!Stepper<Topology>::prepare(m)) {
+        return;
+      }
+
+      auto divide = [&m, &adj, seed](const Chamber& c, Chamber& first, Chamber& second) {
+        return Stepper<Topology>::divide(m, adj, seed, c, first, second) > 0u;
+      };
+
+      auto interrupted = [context]() {
+        return context != nullptr && context->cancelled();
+      };
+
+      // Small chambers are divided by the thread which created
+      // them until nothing is left. The cells of the chambers
+      // which can't be divided anymore are published at the end
+      // along with the passages, including the `opened` ones of
+      // the larger chambers they come from.
+      auto sequential = [&divide, &interrupted, context, w, h](const Chamber& root, unsigned opened) {
+        std::vector<Chamber> chambers(1u, root);
+        Chamber first{}, second{};
+        unsigned visited = 0u;
+
+        while (!chambers.empty()) {
+          if (interrupted()) {
+            return;
+          }
+
+          Chamber c = chambers.back();
+          chambers.pop_back();
+
+          if (divide(c, first, second)) {
+            chambers.push_back(second);
+            chambers.push_back(first);
+            ++opened;
+          }
+          else {
+            visited += (c.x1 - c.x0) * (c.y1 - c.y0);
+          }
+        }
+
+        if (context != nullptr) {
+          context->accumulate(visited, opened, 1.0f * visited / (w * h));
+        }
+      };
+
+      // Large chambers spawn a job for one of their halves and
+      // keep dividing the other one.
+      std::function<void(const Chamber&, unsigned)> split =
+        [&](const Chamber& root, unsigned thread) {
+          Chamber c = root;
+          Chamber first{}, second{};
+          unsigned opened = 0u;
+
+          while ((c.x1 - c.x0) * (c.y1 - c.y0) > cutoff) {
+            if (interrupted()) {
+              return;
+            }
+
+            if (!divide(c, first, second)) {
+              break;
+            }
+
+            ++opened;
+
+            pool.spawn(thread,
+              [&split, first](unsigned t) {
+                split(first, t);
+              }
+            );
+
+            c = second;
+          }
+
+          sequential(c, opened);
+        };
+
+      pool.execute(
+        [&split, w, h](unsigned thread) {
+          split(Chamber{0u, 0u, w, h}, thread);
+        }
+      );
+    }
+
+  }
+
+  namespace growingtree {
+
+    std::string
+    policyToString(const Policy& policy) noexcept {
+      switch (policy.selection) {
+        case Selection::Newest:
+          return "newest";
+        case Selection::Random:
+          return "random";
+        case Selection::Oldest:
+          return "oldest";
+        case Selection::Mix:
+          return "mix " + std::to_string(static_cast<int>(policy.newest * 100.0f + 0.5f)) + "%";
+        default:
+          return "unknown";
+      }
+    }
+
+    void
+    generate(Maze& m, std::uint64_t seed, const Policy& policy) {
+      topology::dispatch(m.sides(),
+        [&m, seed, &policy](auto t) {
+          generate<decltype(t)>(m, seed, policy);
+        }
+      );
+    }
+
+    /// @brief - The generation with the growing tree algorithm
+    /// performed in several steps.
+    template <typename Topology>
+    class Stepper: public Generation {
+      public:
+
+        /**
+         * @brief - Create a new generation of the input maze.
+         * @param m - the maze to generate.
+         * @param seed - the seed of the random generator.
+         * @param policy - the policy used to select the cell to
+         *                 expand.
+         * @param workspace - the buffers to use for the generation.
+         */
+        Stepper(Maze& m, std::uint64_t seed, const Policy& policy, Workspace* workspace = nullptr):
+          Generation(m, workspace),
+
+          m_rng(seed),
+          m_policy(policy),
+
+          m_active(this->workspace().allocate<unsigned>(m.width() * m.height())),
+          m_visited(this->workspace().cells(m.width() * m.height())),
+
+          m_head(0u),
+          m_count(0u)
+        {
+          // We start with a grid full of walls.
+          m.close();
+
+          // Each cell is activated at most once so the active cells
+          // fit in a ring buffer as large as the maze: the oldest
+          // cell is at its head and the newest one at its tail.
+          // Select a random starting cell.
+          unsigned id = m_rng.bounded(m.width() * m.height());
+
+          m_active[m_head] = id;
+          ++m_count;
+          m_visited.set(id);
+          ++m_cellsVisited;
+        }
+
+      protected:
+
+        bool
+        advance(unsigned budget) override {
+          // The algorithm is taken from here:
+          // https://weblog.jamisbuck.org/2011/1/27/maze-generation-growing-tree-algorithm
+          unsigned w = m_maze.width();
+          unsigned size = w * m_maze.height();
+          const Adjacency& adj = m_maze.adjacency();
+
+          auto at = [this, size](unsigned pos) -> unsigned& {
+            unsigned id = m_head + pos;
+            return m_active[id >= size ? id - size : id];
+          };
+
+          for ( ; m_count > 0u && budget > 0u ; --budget) {
+            // Pick the position of the cell to expand in the buffer.
+            unsigned pos = 0u;
+            switch (m_policy.selection) {
+              case Selection::Newest:
+                pos = m_count - 1u;
+                break;
+              case Selection::Random:
+                pos = m_rng.bounded(m_count);
+                break;
+              case Selection::Oldest:
+                pos = 0u;
+                break;
+              case Selection::Mix:
+              default:
+                pos = (m_rng.uniform() < m_policy.newest ? m_count - 1u : m_rng.bounded(m_count));
+                break;
+            }
+
+            unsigned& cell = at(pos);
+            unsigned id = cell;
+            const unsigned* cells = adj[id];
+
+            // Generate the unvisited neighbors of this cell, as a
+            // mask of the doors leading to them.
+            unsigned neighbors = 0u;
+
+            for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+              if (cells[d] != Adjacency::BORDER && !m_visited[cells[d]]) {
+                neighbors |= (1u << d);
+              }
+            }
+
+            // In case no neighbors are available, the cell is removed
+            // in constant time: the oldest cell by moving the head of
+            // the buffer, and any other one by replacing it with the
+            // newest cell.
+            if (neighbors == 0u) {
+              if (pos == 0u) {
+                m_head = (m_head + 1u == size ? 0u : m_head + 1u);
+              }
+              else {
+                cell = at(m_count - 1u);
+              }
+
+              --m_count;
+              continue;
+            }
+
+            // Pick a random neighbor, open the door between it and
+            // the current cell, and then activate it.
+            unsigned d = bits::select(neighbors, m_rng.bounded(bits::count(neighbors)));
+
+            unsigned id2 = cells[d];
+            m_maze.m_walls.set(m_maze.template wall<Topology>(id % w, id / w, d, id2));
+            ++m_wallsOpened;
+
+            m_visited.set(id2);
+            ++m_cellsVisited;
+            at(m_count) = id2;
+            ++m_count;
+          }
+
+          return m_count == 0u;
+        }
+
+      private:
+
+        /**
+         * @brief - The random generator used to pick cells.
+         */
+        Random m_rng;
+
+        /**
+         * @brief - The policy used to select the cell to expand.
+         */
+        Policy m_policy;
+
+        /**
+         * @brief - The ring buffer of active cells, as large as the
+         *          maze.
+         */
+        unsigned* m_active;
+
+        /**
+         * @brief - The cells already part of the maze.
+         */
+        Bitset& m_visited;
+
+        /**
+         * @brief - The position of the oldest active cell in the
+         *          ring buffer.
+         */
+        unsigned m_head;
+
+        /**
+         * @brief - The number of active cells.
+         */
+        unsigned m_count;
+    };
+
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, const Policy& policy, Workspace* workspace) {
+      std::unique_ptr<Generation> g;
+      topology::dispatch(m.sides(),
+        [&m, seed, &policy, workspace, &g](auto t) {
+          g = std::make_unique<Stepper<decltype(t)>>(m, seed, policy, workspace);
+        }
+      );
+
+      return g;
+    }
+
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, const Policy& policy) {
+      Stepper<Topology> g(m, seed, policy);
+      g.run();
+    }
+
+  }
+
+  namespace braid {
+
+    /// @brief - The number of rows of each stripe processed by a
+    /// task. It should be at least 2 so that stripes processed at
+    /// the same time do not touch the same rows.
+    constexpr unsigned STRIPE = 64u;
+
+    /// @brief - The cells with an even (resp. odd) abscissa in a
+    /// word of the walls.
+    constexpr Bitset::Word EVEN = 0x5555555555555555ull;
+    constexpr Bitset::Word ODD = ~EVEN;
+
+    /// @brief - The walls around 64 consecutive cells of a row,
+    /// aligned on the cells. The first index is `0` for the row of
+    /// the cells and `1` for the row below, the second index is
+    /// the slot of the walls.
+    struct Window {
+      // The walls owned by the cells.
+      Bitset::Word own[2][3];
+
+      // The walls owned by the cells on the left of the cells.
+      Bitset::Word left[2][3];
+
+      // The walls owned by the cells on the right of the cells.
+      Bitset::Word right[2][3];
+    };
+
+    /**
+     * @brief - Keep the bits set in exactly one of the input words.
+     * @param words - the words to combine.
+     * @return - the bits set only once.
+     */
+    Bitset::Word
+    once(std::initializer_list<Bitset::Word> words) noexcept {
+      Bitset::Word seen = 0u;
+      Bitset::Word many = 0u;
+
+      for (Bitset::Word word : words) {
+        many |= seen & word;
+        seen |= word;
+      }
+
+      return seen & ~many;
+    }
+
+    /**
+     * @brief - Compute the cells of the window with a single open
+     *          door. The walls leading outside of the maze are never
+     *          open so they do not need any specific handling.
+     * @param win - the walls around the cells.
+     * @return - the cells with a single open door.
+     */
+    template <typename Topology>
+    Bitset::Word
+    deadEnds(const Window& win) noexcept;
+
+    template <>
+    Bitset::Word
+    deadEnds<topology::Triangle>(const Window& win) noexcept {
+      // The right and left doors, and the vertical one which is
+      // owned by the cell (when inverted) or by the cell below.
+      return once({
+        win.own[0][0],
+        win.left[0][0],
+        win.own[0][1] | win.own[1][1]
+      });
+    }
+
+    template <>
+    Bitset::Word
+    deadEnds<topology::Square>(const Window& win) noexcept {
+      // The right, left, top and bottom doors.
+      return once({
+        win.own[0][0],
+        win.left[0][0],
+        win.own[0][1],
+        win.own[1][1]
+      });
+    }
+
+    template <>
+    Bitset::Word
+    deadEnds<topology::Hexagon>(const Window& win) noexcept {
+      // The top doors are owned, the bottom one is owned by the
+      // cell below. The bottom right and bottom left doors lead
+      // to the same row for odd hexagons and to the row below
+      // for even ones.
+      return once({
+        win.own[0][0],
+        win.own[0][1],
+        win.own[0][2],
+        win.own[1][1],
+        (win.right[0][0] & ODD) | (win.right[1][0] & EVEN),
+        (win.left[0][2] & ODD) | (win.left[1][2] & EVEN)
+      });
+    }
+
+    void
+    apply(Maze& m, std::uint64_t seed, ThreadPool& pool, float fraction, Context* context) {
+      topology::dispatch(m.sides(),
+        [&m, seed, &pool, fraction, context](auto t) {
+          apply<decltype(t)>(m, seed, pool, fraction, context);
+        }
+      );
+    }
+
+    template <typename Topology>
+    void
+    apply(Maze& m, std::uint64_t seed, ThreadPool& pool, float fraction, Context* context) {
+      unsigned w = m.width();
+      unsigned h = m.height();
+      unsigned words = m.m_stride / Bitset::WORD_BITS;
+      const Adjacency& adj = m.adjacency();
+
+      // Gather the walls around the cells of the word `k` of the
+      // row `y`.
+      auto gather = [&m, words](unsigned y, unsigned k, Window& win) {
+        for (unsigned row = 0u ; row < 2u ; ++row) {
+          for (unsigned slot = 0u ; slot < Topology::SLOTS ; ++slot) {
+            if (row > y) {
+              win.own[row][slot] = 0u;
+              win.left[row][slot] = 0u;
+              win.right[row][slot] = 0u;
+              continue;
+            }
+
+            unsigned first = m.slotIndex(0u, y - row, slot) / Bitset::WORD_BITS;
+            Bitset::Word cur = m.m_walls.word(first + k);
+            Bitset::Word prev = (k > 0u ? m.m_walls.word(first + k - 1u) : 0u);
+            Bitset::Word next = (k + 1u < words ? m.m_walls.word(first + k + 1u) : 0u);
+
+            win.own[row][slot] = cur;
+            win.left[row][slot] = (cur << 1u) | (prev >> (Bitset::WORD_BITS - 1u));
+            win.right[row][slot] = (cur >> 1u) | (next << (Bitset::WORD_BITS - 1u));
+          }
+        }
+      };
+
+      // Whether the dead end at the input index is removed: this
+      // only depends on the cell.
+      auto picked = [seed, fraction](unsigned id) {
+        std::uint64_t hash = Random::mix(seed, id);
+        return static_cast<double>(hash >> 11u) * 0x1.0p-53 < fraction;
+      };
+
+      // Remove the dead end at the input coordinates, if it is
+      // still one and it is picked. Return whether a wall was
+      // opened.
+      auto remove = [&](unsigned x, unsigned y) {
+        unsigned id = y * w + x;
+        if (!picked(id)) {
+          return false;
+        }
+
+        // The dead end might have been removed by a neighbor.
+        std::uint8_t open = m.template doors<Topology>(x, y);
+        if (bits::count(open) != 1u) {
+          return false;
+        }
+
+        // Favor walls leading to another picked dead end, which
+        // removes both at once. Otherwise avoid walls leading to
+        // a dead end which is not picked, so that the fraction of
+        // removed dead ends is respected.
+        const unsigned* cells = adj[id];
+        unsigned closed = 0u;
+        unsigned ends = 0u;
+        unsigned others = 0u;
+
+        for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+          unsigned other = cells[d];
+          if (other == Adjacency::BORDER || (open & (1u << d)) != 0u) {
+            continue;
+          }
+
+          closed |= (1u << d);
+          if (bits::count(m.template doors<Topology>(other % w, other / w)) != 1u) {
+            others |= (1u << d);
+          }
+          else if (picked(other)) {
+            ends |= (1u << d);
+          }
+        }
+
+        unsigned candidates = (ends != 0u ? ends : (others != 0u ? others : closed));
+        if (candidates == 0u) {
+          return false;
+        }
+
+        std::uint64_t hash = Random::mix(Random::mix(seed, id));
+        unsigned pick = static_cast<unsigned>(((hash >> 32u) * bits::count(candidates)) >> 32u);
+        unsigned d = bits::select(candidates, pick);
+
+        m.m_walls.set(m.template wall<Topology>(x, y, d, cells[d]));
+        return true;
+      };
+
+      // Braid the rows of a stripe from the bottom to the top. The
+      // dead ends of a row are found 64 cells at a time from the
+      // packed walls, then removed one by one.
+      auto stripe = [&](unsigned id) {
+        // The stripes left are skipped in case the braiding is
+        // cancelled.
+        if (context != nullptr && context->cancelled()) {
+          return;
+        }
+
+        unsigned begin = id * STRIPE;
+        unsigned end = std::min(h, begin + STRIPE);
+        unsigned opened = 0u;
+        Window win;
+
+        for (unsigned y = begin ; y < end ; ++y) {
+          for (unsigned k = 0u ; k < words ; ++k) {
+            gather(y, k, win);
+            Bitset::Word ends = deadEnds<Topology>(win);
+
+            // Ignore the padding at the end of the row.
+            unsigned x0 = k * Bitset::WORD_BITS;
+            if (w - x0 < Bitset::WORD_BITS) {
+              ends &= (Bitset::Word(1u) << (w - x0)) - 1u;
+            }
+
+            while (ends != 0u) {
+              opened += (remove(x0 + bits::select(ends, 0u), y) ? 1u : 0u);
+              ends &= ends - 1u;
+            }
+          }
+        }
+
+        if (context != nullptr) {
+          context->accumulate(0u, opened, 0.0f);
+        }
+      };
+
+      // A dead end only modifies the walls of its row and of the
+      // row below, and reads the ones of the rows around: the even
+      // stripes are processed first and then the odd ones, so that
+      // stripes processed at the same time never share any rows.
+      unsigned stripes = (h + STRIPE - 1u) / STRIPE;
+
+      for (unsigned phase = 0u ; phase < 2u ; ++phase) {
+        unsigned tasks = (stripes + 1u - phase) / 2u;
+
+        pool.run(tasks,
+          [&stripe, phase](unsigned task, unsigned /*thread*/) {
+            stripe(2u * task + phase);
+          }
+        );
       }
     }
 
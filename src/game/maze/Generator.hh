@@ -3,7 +3,8 @@
 
 # include <string>
 # include <vector>
-# include "Cell.hh"
+# include <memory>
+# include <cstdint>
 
 namespace maze {
 
@@ -13,7 +14,16 @@ namespace maze {
   enum class Strategy {
     RandomizedKruskal,
     RandomizedPrim,
-    DepthFirst
+    DepthFirst,
+    Wilson,
+    AldousBroder,
+    Eller,
+    BinaryTree,
+    Sidewinder,
+    ParallelKruskal,
+    Boruvka,
+    RecursiveDivision,
+    GrowingTree
   };
 
   /**
@@ -24,20 +34,119 @@ namespace maze {
   std::string
   strategyToString(const Strategy& st) noexcept;
 
-  /// @brief - Convenience define for a list of cells.
-  using Cells = std::vector<Cell>;
+  /**
+   * @brief - Whether the strategy is able to use several threads
+   *          to generate a single maze.
+   * @param st - the strategy to analyze.
+   * @return - `true` if the strategy runs in parallel.
+   */
+  bool
+  strategyIsParallel(const Strategy& st) noexcept;
 
   /// @brief - Forward declaration of the maze class.
   class Maze;
 
+  /// @brief - Forward declaration of the helpers of the generation.
+  class Bitset;
+  class Random;
+  class ThreadPool;
+  class Generation;
+  class Workspace;
+  class Context;
+
   namespace kruksal {
 
     /**
      * @brief - Generate a maze with a random Kruksal algorithm.
      * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator: the same
+     *               seed always produces the same maze.
+     */
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    template <typename Topology>
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with the Kruksal
+     *          algorithm which can be performed in several steps.
+     *          The result is the same as the one of the
+     *          `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr);
+
+    /**
+     * @brief - Generate a maze with a random Kruksal algorithm
+     *          using the threads of the input pool. The walls are
+     *          processed in parallel by chunks and the conflicts
+     *          are resolved by reserving the regions they merge:
+     *          the result is exactly the one of the sequential
+     *          version with the same seed.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param pool - the threads to use for the generation.
+     * @param context - checked for cancellation before each chunk
+     *                  of walls and receiving the walls opened by
+     *                  the chunk. Can be `null`.
      */
     void
-    generate(Maze& m);
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context = nullptr);
+
+    /**
+     * @brief - Specialization of the parallel generation for a
+     *          topology.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param pool - the threads to use for the generation.
+     * @param context - the context of the generation or `null`.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context);
+
+    /// @brief - Convenience structure defining a wall: this helps
+    /// speeding up the process of picking a door.
+    struct Door {
+      // The linear index of the starting cell.
+      unsigned id;
+
+      // The linear index of the cell on the other side.
+      unsigned other;
+
+      // The index of the wall in the walls of the maze.
+      unsigned wall;
+    };
+
+    /**
+     * @brief - Gather the walls between two cells of the maze and
+     *          shuffle them: this is the order in which the walls
+     *          are considered by the algorithm.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param doors - output argument receiving the walls.
+     */
+    template <typename Topology>
+    void
+    shuffled(Maze& m, std::uint64_t seed, std::vector<Door>& doors);
 
   }
 
@@ -46,9 +155,40 @@ namespace maze {
     /**
      * @brief - Generate a maze with a randomized Prim algorithm.
      * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator: the same
+     *               seed always produces the same maze.
      */
     void
-    generate(Maze& m);
+    generate(Maze& m, std::uint64_t seed);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    template <typename Topology>
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with the Prim
+     *          algorithm which can be performed in several steps.
+     *          The result is the same as the one of the
+     *          `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr);
 
   }
 
@@ -57,9 +197,538 @@ namespace maze {
     /**
      * @brief - Generate a maze with a depth first algorithm.
      * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator: the same
+     *               seed always produces the same maze.
+     */
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    template <typename Topology>
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with the
+     *          depth-first algorithm which can be performed in
+     *          several steps. The result is the same as the one
+     *          of the `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr);
+
+  }
+
+  namespace wilson {
+
+    /**
+     * @brief - Generate a maze with Wilson's algorithm: this
+     *          produces a uniform spanning tree of the cells.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator: the same
+     *               seed always produces the same maze.
+     */
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    template <typename Topology>
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with Wilson's
+     *          algorithm which can be performed in several steps.
+     *          The result is the same as the one of the
+     *          `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr);
+
+  }
+
+  namespace aldousbroder {
+
+    /// @brief - The default fraction of the cells visited by the
+    /// random walk before switching to Wilson's algorithm.
+    constexpr float DEFAULT_SWITCH_FRACTION = 0.3f;
+
+    /**
+     * @brief - Generate a maze with the Aldous-Broder algorithm:
+     *          this produces a uniform spanning tree of the cells.
+     *          As the random walk takes longer and longer to find
+     *          unvisited cells, the generation switches to Wilson's
+     *          algorithm once enough cells are visited: the result
+     *          is still unbiased.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator: the same
+     *               seed always produces the same maze.
+     * @param fraction - the fraction of the cells to visit with
+     *                   the random walk before switching to the
+     *                   Wilson's algorithm. A value of `1` only
+     *                   uses the random walk.
+     */
+    void
+    generate(Maze& m,
+             std::uint64_t seed,
+             float fraction = DEFAULT_SWITCH_FRACTION);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param fraction - the fraction of the cells to visit with
+     *                   the random walk.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, float fraction);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    template <typename Topology>
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with the
+     *          Aldous-Broder algorithm which can be performed in
+     *          several steps. The result is the same as the one
+     *          of the `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param fraction - the fraction of the cells to visit with
+     *                   the random walk.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m,
+          std::uint64_t seed,
+          float fraction = DEFAULT_SWITCH_FRACTION,
+          Workspace* workspace = nullptr);
+
+  }
+
+  namespace eller {
+
+    /**
+     * @brief - Generate a maze with Eller's algorithm. The maze
+     *          is produced one row at a time (see the class
+     *          `RowGenerator`) which does not depend on the
+     *          topology of the cells.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator: the same
+     *               seed always produces the same maze.
+     */
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with Eller's
+     *          algorithm which can be performed in several steps.
+     *          The result is the same as the one of the
+     *          `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr);
+
+  }
+
+  namespace binarytree {
+
+    /**
+     * @brief - Generate a maze with the binary tree algorithm:
+     *          each cell opens either its right or its top door.
+     *          This is only available for square cells: 64 cells
+     *          are processed at once from a single random word.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator: the same
+     *               seed always produces the same maze.
+     */
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with the binary
+     *          tree algorithm which can be performed in several
+     *          steps. The result is the same as the one of the
+     *          `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr);
+
+  }
+
+  namespace sidewinder {
+
+    /**
+     * @brief - Generate a maze with the sidewinder algorithm: each
+     *          row is split in random runs of cells connected to
+     *          each other, and each run opens the top door of one
+     *          of its cells. This is only available for square
+     *          cells: the runs of 64 cells are decided at once
+     *          from a single random word.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator: the same
+     *               seed always produces the same maze.
+     */
+    void
+    generate(Maze& m, std::uint64_t seed);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with the
+     *          sidewinder algorithm which can be performed in
+     *          several steps. The result is the same as the one
+     *          of the `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr);
+
+  }
+
+  namespace tiles {
+
+    /// @brief - The default size in cells of the side of the tiles
+    /// used in the parallel generation.
+    constexpr unsigned DEFAULT_TILE_SIZE = 128u;
+
+    /**
+     * @brief - Generate a maze in parallel: the maze is split in
+     *          square tiles generated independently with the
+     *          strategy of the maze, each one with a seed derived
+     *          from the input one. The tiles are then connected
+     *          by opening a random spanning set of the walls on
+     *          their boundaries. The result only depends on the
+     *          seed and not on the number of threads used.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param pool - the threads to use to generate the tiles.
+     * @param size - the size of the side of the tiles in cells.
+     *               It is rounded up to a multiple of 64 so that
+     *               the tiles never share a word of the walls.
+     *               The tiles on the right and top borders of the
+     *               maze also include the remaining cells.
+     * @param context - checked for cancellation before generating
+     *                  each tile, which then publishes its cells.
+     *                  Can be `null`.
+     */
+    void
+    generate(Maze& m,
+             std::uint64_t seed,
+             ThreadPool& pool,
+             unsigned size = DEFAULT_TILE_SIZE,
+             Context* context = nullptr);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param pool - the threads to use to generate the tiles.
+     * @param size - the size of the side of the tiles in cells.
+     * @param context - the context of the generation or `null`.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, unsigned size, Context* context);
+
+  }
+
+  namespace boruvka {
+
+    /**
+     * @brief - Generate a maze with the Borůvka's algorithm using
+     *          the threads of the input pool. Each wall receives a
+     *          random weight derived from the seed and the maze is
+     *          the minimum spanning tree of the cells for these
+     *          weights. As the weights are all different this tree
+     *          is unique: the result does not depend on the number
+     *          of threads.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param pool - the threads to use for the generation.
+     * @param context - checked for cancellation before each round
+     *                  and each group of cells of a round, and
+     *                  receiving the walls opened by the rounds.
+     *                  Can be `null`.
+     */
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context = nullptr);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param pool - the threads to use for the generation.
+     * @param context - the context of the generation or `null`.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context);
+
+  }
+
+  namespace recursivedivision {
+
+    /// @brief - The number of cells of a chamber below which it is
+    /// divided by a single thread.
+    constexpr unsigned DEFAULT_CUTOFF = 4096u;
+
+    /**
+     * @brief - Generate a maze with the recursive division algorithm
+     *          using the threads of the input pool. The maze starts
+     *          without any wall and is recursively divided in two
+     *          chambers by a line of walls with a single passage.
+     *          The two chambers are independent so they are divided
+     *          as separate jobs of the pool. The division of each
+     *          chamber only depends on the seed and on its position
+     *          so the result does not depend on the number of
+     *          threads.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param pool - the threads to use for the generation.
+     * @param cutoff - the number of cells of a chamber below which
+     *                 it is divided without spawning other jobs.
+     * @param context - checked for cancellation before dividing each
+     *                  chamber, and receiving the cells of the ones
+     *                  which can't be divided anymore. Can be `null`.
+     */
+    void
+    generate(Maze& m,
+             std::uint64_t seed,
+             ThreadPool& pool,
+             unsigned cutoff = DEFAULT_CUTOFF,
+             Context* context = nullptr);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param pool - the threads to use for the generation.
+     * @param cutoff - the number of cells of a chamber below which
+     *                 it is divided without spawning other jobs.
+     * @param context - the context of the generation or `null`.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, ThreadPool& pool, unsigned cutoff, Context* context);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    template <typename Topology>
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with the
+     *          recursive division algorithm which can be
+     *          performed in several steps by a single thread. The
+     *          result is the same as the one of the `generate`
+     *          method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m, std::uint64_t seed, Workspace* workspace = nullptr);
+
+  }
+
+  namespace growingtree {
+
+    /// @brief - The ways to pick the cell to expand among the cells
+    /// which may still have unvisited neighbors.
+    enum class Selection {
+      Newest,
+      Random,
+      Oldest,
+      Mix
+    };
+
+    /// @brief - The probability to pick the newest cell rather than
+    /// a random one with the `Mix` selection.
+    constexpr float DEFAULT_NEWEST_PROBABILITY = 0.5f;
+
+    /// @brief - Convenience structure defining how the growing tree
+    /// algorithm picks the cell to expand.
+    struct Policy {
+      // The way to pick the cell to expand.
+      Selection selection;
+
+      // The probability to pick the newest cell rather than a
+      // random one. Only used by the `Mix` selection.
+      float newest;
+    };
+
+    /// @brief - The policy used by default: it produces mazes
+    /// in between the ones of the depth-first and of the Prim's
+    /// algorithms.
+    constexpr Policy DEFAULT_POLICY = Policy{Selection::Mix, DEFAULT_NEWEST_PROBABILITY};
+
+    /**
+     * @brief - Convert a policy to a human readable string.
+     * @param policy - the policy to translate to a string.
+     * @return - the name of the policy.
+     */
+    std::string
+    policyToString(const Policy& policy) noexcept;
+
+    /**
+     * @brief - Generate a maze with the growing tree algorithm. The
+     *          maze grows from a random cell: a cell is picked among
+     *          the active ones according to the policy and one of its
+     *          unvisited neighbors is connected to it and activated.
+     *          Cells without unvisited neighbors are deactivated.
+     *          The active cells and the visited cells are taken from
+     *          a workspace living for this generation only.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param policy - how to pick the cell to expand.
+     */
+    void
+    generate(Maze& m, std::uint64_t seed, const Policy& policy = DEFAULT_POLICY);
+
+    /**
+     * @brief - Specialization of the generation for a topology.
+     *          The topology should match the cells of the maze.
+     * @param m - the maze used to query properties about cells.
+     * @param seed - the seed of the random generator.
+     * @param policy - how to pick the cell to expand.
+     */
+    template <typename Topology>
+    void
+    generate(Maze& m, std::uint64_t seed, const Policy& policy);
+
+    /// @brief - Forward declaration of the generation performed in
+    /// several steps (see the `Generation` class).
+    template <typename Topology>
+    class Stepper;
+
+    /**
+     * @brief - Prepare a generation of the maze with the growing
+     *          tree algorithm which can be performed in several
+     *          steps. The result is the same as the one of the
+     *          `generate` method.
+     * @param m - the maze to generate.
+     * @param seed - the seed of the random generator.
+     * @param policy - how to pick the cell to expand.
+     * @param workspace - the buffers to use for the generation or
+     *                    `null` to allocate new ones.
+     * @return - the generation, to be advanced by the caller.
+     */
+    std::unique_ptr<Generation>
+    start(Maze& m,
+          std::uint64_t seed,
+          const Policy& policy = DEFAULT_POLICY,
+          Workspace* workspace = nullptr);
+
+  }
+
+  namespace braid {
+
+    /// @brief - The fraction of dead ends removed by default.
+    constexpr float DEFAULT_FRACTION = 0.5f;
+
+    /**
+     * @brief - Remove a fraction of the dead ends of the maze by
+     *          opening one more of their walls, which creates loops.
+     *          This is meant to be applied on a generated maze. The
+     *          wall leads to another dead end when possible so that
+     *          both are removed. The maze is processed by stripes
+     *          of rows on the threads of the pool: the decisions for
+     *          each cell only depend on the seed and on the cell so
+     *          the result does not depend on the number of threads.
+     * @param m - the maze to braid.
+     * @param seed - the seed used to pick the dead ends and walls.
+     * @param pool - the threads to use to braid the maze.
+     * @param fraction - the fraction of dead ends to remove, in the
+     *                   range `[0; 1]`.
+     * @param context - checked for cancellation before each stripe,
+     *                  which then publishes the walls it opened. In
+     *                  case it is cancelled, the maze is only partly
+     *                  braided. Can be `null`.
+     */
+    void
+    apply(Maze& m,
+          std::uint64_t seed,
+          ThreadPool& pool,
+          float fraction = DEFAULT_FRACTION,
+          Context* context = nullptr);
+
+    /**
+     * @brief - Specialization of the braiding for a topology. The
+     *          topology should match the cells of the maze.
+     * @param m - the maze to braid.
+     * @param seed - the seed used to pick the dead ends and walls.
+     * @param pool - the threads to use to braid the maze.
+     * @param fraction - the fraction of dead ends to remove.
+     * @param context - the context of the braiding or `null`.
      */
+    template <typename Topology>
     void
-    generate(Maze& m);
+    apply(Maze& m, std::uint64_t seed, ThreadPool& pool, float fraction, Context* context);
 
   }
 }
@@ -64,6 +64,17 @@ namespace maze {
       unsigned
       idFromDoorAndCell(unsigned x, unsigned y, unsigned door) const override;
 
+      /**
+       * @brief - Implementation of the interface method to determine
+       *          whether a cell owns a door.
+       * @param door - the index of the door.
+       * @param inverted - whether the cell is inverted.
+       * @param slot - output argument defining the slot of the wall.
+       * @return - `true` if the cell owns the door.
+       */
+      bool
+      owns(unsigned door, bool inverted, unsigned& slot) const noexcept override;
+
       /**
        * @brief - Implementation of the interface method to name a door.
        * @param id - the index of the door in the cell.
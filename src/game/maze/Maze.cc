@@ -23,7 +23,14 @@ namespace maze {
 
     m_cellSides(sides),
 
-    m_cells(m_width * m_height, Cell(m_cellSides, false))
+    // Each cell owns half of its doors (rounded up).
+    m_slots((m_cellSides + 1u) / 2u),
+    m_stride(((m_width + 63u) / 64u) * 64u),
+    m_walls(m_slots * m_height * m_stride),
+
+    m_adjacency(),
+
+    m_policy(growingtree::DEFAULT_POLICY)
   {
     setService("maze");
   }
@@ -43,7 +50,7 @@ namespace maze {
     return m_cellSides;
   }
 
-  const Cell&
+  Cell
   Maze::at(unsigned x, unsigned y) const {
     if (x >= m_width || y >= m_height) {
       error(
@@ -52,32 +59,71 @@ namespace maze {
       );
     }
 
-    return m_cells[linear(x, y)];
+    return Cell(m_cellSides, doors(x, y));
   }
 
-  Cell
-  Maze::at(unsigned x, unsigned y) {
-    if (x >= m_width || y >= m_height) {
-      error(
-        "Failed to fetch cell at coordinate " + std::to_string(x) + "x" + std::to_string(y),
-        "Maze only has dimensions " + std::to_string(m_width) + "x" + std::to_string(m_height)
+  const Adjacency&
+  Maze::adjacency() const {
+    if (!m_adjacency.matches(m_width, m_height, m_cellSides)) {
+      topology::dispatch(m_cellSides,
+        [this](auto t) {
+          m_adjacency.template build<decltype(t)>(m_width, m_height);
+        }
       );
     }
 
-    return m_cells[linear(x, y)];
+    return m_adjacency;
   }
 
   void
   Maze::open() {
-    for (unsigned id = 0u ; id < m_cells.size() ; ++id) {
-      m_cells[id].open();
-    }
+    // Only the walls between two cells of the maze can be
+    // opened: the border of the maze stays closed.
+    m_walls.clear();
+
+    const Adjacency& adj = adjacency();
+
+    topology::dispatch(m_cellSides,
+      [this, &adj](auto t) {
+        using Topology = decltype(t);
+
+        for (unsigned y = 0u ; y < m_height ; ++y) {
+          for (unsigned x = 0u ; x < m_width ; ++x) {
+            const unsigned* neighbors = adj[linear(x, y)];
+            bool inv = Topology::inverted(x, y);
+
+            unsigned slot = 0u;
+            for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+              if (neighbors[d] != Adjacency::BORDER && Topology::owns(d, inv, slot)) {
+                m_walls.set(slotIndex(x, y, slot));
+              }
+            }
+          }
+        }
+      }
+    );
   }
 
   void
   Maze::close() {
-    for (unsigned id = 0u ; id < m_cells.size() ; ++id) {
-      m_cells[id].close();
+    m_walls.clear();
+  }
+
+  MazeShPtr
+  Maze::create(unsigned width,
+               unsigned height,
+               const Strategy& strategy,
+               unsigned sides)
+  {
+    switch (sides) {
+      case topology::Triangle::SIDES:
+        return std::make_shared<TriangleMaze>(width, height, strategy);
+      case topology::Square::SIDES:
+        return std::make_shared<SquareMaze>(width, height, strategy);
+      case topology::Hexagon::SIDES:
+        return std::make_shared<HexagonMaze>(width, height, strategy);
+      default:
+        return nullptr;
     }
   }
 
@@ -112,31 +158,22 @@ namespace maze {
       );
     }
 
-    MazeShPtr mz;
-    switch (sides) {
-      case 3u:
-        mz = std::make_shared<TriangleMaze>(w, h, Strategy::RandomizedKruskal);
-        break;
-      case 4u:
-        mz = std::make_shared<SquareMaze>(w, h, Strategy::RandomizedKruskal);
-        break;
-      case 6u:
-      default:
-        mz = std::make_shared<HexagonMaze>(w, h, Strategy::RandomizedKruskal);
-        break;
-    }
+    MazeShPtr mz = create(w, h, Strategy::RandomizedKruskal, sides);
 
     // Read the cells.
     utils::BitReader br(out);
     for (unsigned y = 0u ; y < h ; ++y) {
       for (unsigned x = 0u ; x < w ; ++x) {
-        // Reset the doors of the cell.
-        Cell& c = mz->m_cells[mz->linear(x, y)];
-        c.close();
-
-        // Update doors based on the content of the file.
-        for (unsigned d = 0u ; d < c.doors() ; ++d) {
-          c.toggle(d, br.read());
+        Opening o(x, y, sides, mz->inverted(x, y));
+        mz->prepareOpening(o);
+
+        // Update doors based on the content of the file. Doors
+        // leading outside of the maze are always closed.
+        for (unsigned d = 0u ; d < sides ; ++d) {
+          bool open = br.read();
+          if (open && o.canBeOpened(d)) {
+            mz->toggle(x, y, d, true);
+          }
         }
       }
     }
@@ -172,10 +209,12 @@ namespace maze {
     // provided by the fstream but we can accumulate the
     // bits and flush them when needed.
     utils::BitWriter bw(out);
-    for (unsigned id = 0u ; id < m_cells.size() ; ++id) {
-      const Cell& c = m_cells[id];
-      for (unsigned d = 0u ; d < c.doors() ; ++d) {
-        bw.push(c(d));
+    for (unsigned y = 0u ; y < m_height ; ++y) {
+      for (unsigned x = 0u ; x < m_width ; ++x) {
+        std::uint8_t mask = doors(x, y);
+        for (unsigned d = 0u ; d < m_cellSides ; ++d) {
+          bw.push((mask >> d) & 1u);
+        }
       }
     }
 
@@ -188,21 +227,56 @@ namespace maze {
   }
 
   void
-  Maze::generate() {
+  Maze::generate(std::uint64_t seed) {
     // Nothing to generate if the maze is empty.
-    if (m_cells.empty()) {
+    if (m_width == 0u || m_height == 0u) {
       return;
     }
 
     switch (m_strategy) {
       case Strategy::RandomizedKruskal:
-        kruksal::generate(*this);
+        kruksal::generate(*this, seed);
         break;
       case Strategy::RandomizedPrim:
-        prim::generate(*this);
+        prim::generate(*this, seed);
         break;
       case Strategy::DepthFirst:
-        depthfirst::generate(*this);
+        depthfirst::generate(*this, seed);
+        break;
+      case Strategy::Wilson:
+        wilson::generate(*this, seed);
+        break;
+      case Strategy::AldousBroder:
+        aldousbroder::generate(*this, seed);
+        break;
+      case Strategy::Eller:
+        eller::generate(*this, seed);
+        break;
+      case Strategy::BinaryTree:
+        binarytree::generate(*this, seed);
+        break;
+      case Strategy::Sidewinder:
+        sidewinder::generate(*this, seed);
+        break;
+      case Strategy::ParallelKruskal: {
+        // Only the calling thread is used: the result is the
+        // same as with more threads.
+        ThreadPool pool(1u);
+        kruksal::generate(*this, seed, pool);
+        break;
+      }
+      case Strategy::Boruvka: {
+        ThreadPool pool(1u);
+        boruvka::generate(*this, seed, pool);
+        break;
+      }
+      case Strategy::RecursiveDivision: {
+        ThreadPool pool(1u);
+        recursivedivision::generate(*this, seed, pool);
+        break;
+      }
+      case Strategy::GrowingTree:
+        growingtree::generate(*this, seed, m_policy);
         break;
       default:
         warn(
@@ -213,9 +287,155 @@ namespace maze {
     }
   }
 
+  void
+  Maze::generate(std::uint64_t seed, ThreadPool& pool, Context* context) {
+    // Nothing to generate if the maze is empty.
+    if (m_width == 0u || m_height == 0u) {
+      return;
+    }
+
+    // Strategies able to use several threads are used as is,
+    // the others are applied on tiles of the maze.
+    switch (m_strategy) {
+      case Strategy::ParallelKruskal:
+        kruksal::generate(*this, seed, pool, context);
+        break;
+      case Strategy::Boruvka:
+        boruvka::generate(*this, seed, pool, context);
+        break;
+      case Strategy::RecursiveDivision:
+        recursivedivision::generate(*this, seed, pool, recursivedivision::DEFAULT_CUTOFF, context);
+        break;
+      default:
+        tiles::generate(*this, seed, pool, tiles::DEFAULT_TILE_SIZE, context);
+        break;
+    }
+
+    // An interrupted generation leaves the maze in a state which
+    // does not depend on when it stopped.
+    if (context != nullptr && context->cancelled()) {
+      close();
+    }
+  }
+
+  std::unique_ptr<Generation>
+  Maze::generation(std::uint64_t seed, Context* context, Workspace* workspace) {
+    std::unique_ptr<Generation> g;
+
+    // An empty maze is generated in a single step: the same goes
+    // for the strategies running on several threads.
+    if (m_width > 0u && m_height > 0u) {
+      switch (m_strategy) {
+        case Strategy::RandomizedKruskal:
+          g = kruksal::start(*this, seed, workspace);
+          break;
+        case Strategy::RandomizedPrim:
+          g = prim::start(*this, seed, workspace);
+          break;
+        case Strategy::DepthFirst:
+          g = depthfirst::start(*this, seed, workspace);
+          break;
+        case Strategy::Wilson:
+          g = wilson::start(*this, seed, workspace);
+          break;
+        case Strategy::AldousBroder:
+          g = aldousbroder::start(*this, seed, aldousbroder::DEFAULT_SWITCH_FRACTION, workspace);
+          break;
+        case Strategy::Eller:
+          g = eller::start(*this, seed, workspace);
+          break;
+        case Strategy::BinaryTree:
+          g = binarytree::start(*this, seed, workspace);
+          break;
+        case Strategy::Sidewinder:
+          g = sidewinder::start(*this, seed, workspace);
+          break;
+        case Strategy::RecursiveDivision:
+          g = recursivedivision::start(*this, seed, workspace);
+          break;
+        case Strategy::GrowingTree:
+          g = growingtree::start(*this, seed, m_policy, workspace);
+          break;
+        default:
+          break;
+      }
+    }
+
+    if (g == nullptr) {
+      g = std::make_unique<Batch>(*this,
+        [seed](Maze& m, Context* context) {
+          // Only the calling thread is used: the result is the
+          // same as with more threads.
+          ThreadPool pool(1u);
+          m.generate(seed, pool, context);
+        }
+      );
+    }
+
+    g->setContext(context);
+
+    return g;
+  }
+
+  void
+  Maze::braid(std::uint64_t seed, float fraction, ThreadPool& pool, Context* context) {
+    // Nothing to braid if the maze is empty.
+    if (m_width == 0u || m_height == 0u || fraction <= 0.0f) {
+      return;
+    }
+
+    braid::apply(*this, seed, pool, fraction, context);
+  }
+
+  void
+  Maze::setPolicy(const growingtree::Policy& policy) noexcept {
+    m_policy = policy;
+  }
+
+  void
+  Maze::reshape(unsigned width, unsigned height, const Strategy& strategy) {
+    m_width = width;
+    m_height = height;
+    m_strategy = strategy;
+
+    // The walls are resized without releasing their memory: the
+    // adjacency table is rebuilt in place when next needed.
+    m_stride = ((m_width + 63u) / 64u) * 64u;
+    m_walls.reset(m_slots * m_height * m_stride);
+  }
+
   unsigned
-  Maze::linear(unsigned x, unsigned y) const noexcept {
-    return y * m_width + x;
+  Maze::wall(unsigned x, unsigned y, unsigned door) const {
+    unsigned id = 0u;
+    topology::dispatch(m_cellSides,
+      [this, x, y, door, &id](auto t) {
+        id = wall<decltype(t)>(x, y, door);
+      }
+    );
+
+    return id;
+  }
+
+  void
+  Maze::toggle(unsigned x, unsigned y, unsigned door, bool open) {
+    if (open) {
+      m_walls.set(wall(x, y, door));
+    }
+    else {
+      m_walls.unset(wall(x, y, door));
+    }
+  }
+
+  std::uint8_t
+  Maze::doors(unsigned x, unsigned y) const {
+    std::uint8_t mask = 0u;
+    topology::dispatch(m_cellSides,
+      [this, x, y, &mask](auto t) {
+        mask = doors<decltype(t)>(x, y);
+      }
+    );
+
+    return mask;
   }
 
 }
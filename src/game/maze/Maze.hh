@@ -3,10 +3,17 @@
 
 # include <memory>
 # include <vector>
+# include <cstdint>
 # include <core_utils/CoreObject.hh>
 # include "Cell.hh"
 # include "Opening.hh"
+# include "Bitset.hh"
+# include "Topology.hh"
+# include "Adjacency.hh"
+# include "ThreadPool.hh"
 # include "Generator.hh"
+# include "Generation.hh"
+# include "Context.hh"
 
 namespace maze {
 
@@ -54,21 +61,24 @@ namespace maze {
       /**
        * @brief - Return the cell at the specified index. In case
        *          the coordinates are not valid an error is raised.
+       *          The cell is a lightweight copy of the state of
+       *          the doors stored in the maze.
        * @param x - the x coordinate of the cell to fetch.
        * @param y - the y coordinate of the cell to fetch.
        * @return - the cell at the specified coordinates.
        */
-      const Cell&
+      Cell
       at(unsigned x, unsigned y) const;
 
       /**
-       * @brief - Constant version of accessing a cell.
-       * @param x - the x coordinate of the cell to fetch.
-       * @param y - the y coordinate of the cell to fetch.
-       * @return - the cell at the specified coordinates.
+       * @brief - Return the table describing the neighbors of each
+       *          cell of the maze. It is computed the first time it
+       *          is needed and then reused as long as the maze keeps
+       *          the same dimensions.
+       * @return - the neighbors of the cells of the maze.
        */
-      Cell
-      at(unsigned x, unsigned y);
+      const Adjacency&
+      adjacency() const;
 
       /**
        * @brief - Opens all the doors of all the cells defined in
@@ -84,6 +94,23 @@ namespace maze {
       void
       close();
 
+      /**
+       * @brief - Create a new maze with cells having the specified
+       *          number of sides. In case the number of sides is not
+       *          supported a null pointer is returned.
+       * @param width - the width of the maze in cells.
+       * @param height - the height of the maze in cells.
+       * @param strategy - the strategy to use to generate the maze.
+       * @param sides - the number of sides of the cells.
+       * @return - the created maze.
+       */
+      static
+      MazeShPtr
+      create(unsigned width,
+             unsigned height,
+             const Strategy& strategy,
+             unsigned sides);
+
       /**
        * @brief - Create a new maze from the data defined in the
        *          input file. In case the data can't be parsed an
@@ -113,9 +140,87 @@ namespace maze {
        *          and some hooks are provided for inheriting mazes
        *          with different cell types to handle the specific
        *          part of the process.
+       *          The generation is deterministic: the same seed
+       *          always produces the same maze.
+       * @param seed - the seed of the random generator.
+       */
+      void
+      generate(std::uint64_t seed);
+
+      /**
+       * @brief - Generate a new maze using the threads of the input
+       *          pool. Strategies able to run in parallel (see the
+       *          `strategyIsParallel` method) use the threads as is.
+       *          For the other ones, the maze is split in tiles which
+       *          are generated independently with the strategy of the
+       *          maze and then connected (see `tiles::generate`).
+       *          The result only depends on the seed and not on the
+       *          number of threads of the pool.
+       * @param seed - the seed of the random generator.
+       * @param pool - the threads to use for the generation.
+       * @param context - the context used to follow the progress of
+       *                  the generation and to cancel it, if any. In
+       *                  case the generation is cancelled, the maze
+       *                  is left with all its walls closed.
        */
       void
-      generate();
+      generate(std::uint64_t seed, ThreadPool& pool, Context* context = nullptr);
+
+      /**
+       * @brief - Prepare the generation of a new maze which can be
+       *          performed in several steps (see `Generation::step`).
+       *          The result is the same as the one of the `generate`
+       *          method with the same seed. Strategies running on
+       *          several threads are performed in a single step.
+       *          The maze should not be modified until the generation
+       *          is over.
+       * @param seed - the seed of the random generator.
+       * @param context - the context used to follow the progress
+       *                  of the generation and to cancel it, if any
+       *                  (see `Generation::setContext`).
+       * @param workspace - the buffers used by the generation or
+       *                    `null` to allocate new ones. Reusing the
+       *                    same workspace avoids allocations when
+       *                    generating several mazes.
+       * @return - the generation of the maze.
+       */
+      std::unique_ptr<Generation>
+      generation(std::uint64_t seed, Context* context = nullptr, Workspace* workspace = nullptr);
+
+      /**
+       * @brief - Remove a fraction of the dead ends of the maze so
+       *          that it contains loops (see `braid::apply`). This is
+       *          meant to be called after the generation.
+       * @param seed - the seed used to pick the dead ends.
+       * @param fraction - the fraction of dead ends to remove.
+       * @param pool - the threads to use to braid the maze.
+       * @param context - the context used to cancel the braiding, if
+       *                  any. The maze is then only partly braided.
+       */
+      void
+      braid(std::uint64_t seed, float fraction, ThreadPool& pool, Context* context = nullptr);
+
+      /**
+       * @brief - Define the policy used by the growing tree strategy
+       *          to pick the cell to expand. It is not used by other
+       *          strategies.
+       * @param policy - the new policy.
+       */
+      void
+      setPolicy(const growingtree::Policy& policy) noexcept;
+
+      /**
+       * @brief - Change the dimensions and the strategy of the maze
+       *          in place: all its walls are closed. The memory used
+       *          by the walls and the adjacency table is reused when
+       *          it is large enough. The number of sides of the cells
+       *          is defined by the kind of maze and can't be changed.
+       * @param width - the new width of the maze.
+       * @param height - the new height of the maze.
+       * @param strategy - the new strategy to generate the maze.
+       */
+      void
+      reshape(unsigned width, unsigned height, const Strategy& strategy);
 
       /**
        * @brief - Whether or not this cell is inverted. This allows to
@@ -142,6 +247,97 @@ namespace maze {
       unsigned
       linear(unsigned x, unsigned y) const noexcept;
 
+      /**
+       * @brief - Compute the index of the wall corresponding to the
+       *          door of the cell at the specified coordinates in
+       *          the walls store. As each wall is shared between two
+       *          cells, both doors yield the same index.
+       *          Both the cell and the door are assumed to be valid
+       *          and the door should not lead outside of the maze.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @param door - the index of the door.
+       * @return - the index of the wall in the walls store.
+       */
+      unsigned
+      wall(unsigned x, unsigned y, unsigned door) const;
+
+      /**
+       * @brief - Define the state of the door of the cell at the
+       *          input coordinates. As walls are shared, this also
+       *          modifies the state of the door of the cell on the
+       *          other side.
+       *          Both the cell and the door are assumed to be valid
+       *          and the door should not lead outside of the maze.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @param door - the index of the door.
+       * @param open - whether the door is open.
+       */
+      void
+      toggle(unsigned x, unsigned y, unsigned door, bool open);
+
+      /**
+       * @brief - Compute the state of the doors of the cell at the
+       *          specified coordinates from the walls store. The
+       *          coordinates are assumed to be valid.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @return - the state of the doors packed as a bitmask.
+       */
+      std::uint8_t
+      doors(unsigned x, unsigned y) const;
+
+      /**
+       * @brief - Compute the index in the walls store of the wall
+       *          held in the specified slot of a cell.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @param slot - the slot of the wall.
+       * @return - the index of the wall in the walls store.
+       */
+      unsigned
+      slotIndex(unsigned x, unsigned y, unsigned slot) const noexcept;
+
+      /**
+       * @brief - Specialization of the `wall` method for a known
+       *          topology: this does not involve any virtual call.
+       *          The topology should match the number of sides of
+       *          the maze.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @param door - the index of the door.
+       * @return - the index of the wall in the walls store.
+       */
+      template <typename Topology>
+      unsigned
+      wall(unsigned x, unsigned y, unsigned door) const noexcept;
+
+      /**
+       * @brief - Similar to the `wall` method but with the index of
+       *          the neighboring cell already known.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @param door - the index of the door.
+       * @param neighbor - the linear index of the cell on the other
+       *                   side of the door.
+       * @return - the index of the wall in the walls store.
+       */
+      template <typename Topology>
+      unsigned
+      wall(unsigned x, unsigned y, unsigned door, unsigned neighbor) const noexcept;
+
+      /**
+       * @brief - Specialization of the `doors` method for a known
+       *          topology.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @return - the state of the doors packed as a bitmask.
+       */
+      template <typename Topology>
+      std::uint8_t
+      doors(unsigned x, unsigned y) const noexcept;
+
       /**
        * @brief - Used to generate the index of the move going in the
        *          opposite direction based on the geometry of the cells
@@ -180,6 +376,22 @@ namespace maze {
       virtual unsigned
       idFromDoorAndCell(unsigned x, unsigned y, unsigned door) const = 0;
 
+      /**
+       * @brief - Interface method used to determine whether the door
+       *          of a cell is the one storing the state of the wall
+       *          it is part of. Each wall is shared by two cells and
+       *          only one of them holds its state: each cell owns at
+       *          most half of its doors (rounded up) and each of the
+       *          owned door is assigned a slot in the walls store.
+       * @param door - the index of the door.
+       * @param inverted - whether the cell is inverted.
+       * @param slot - output argument defining the slot of the wall
+       *               in case the door is owned by the cell.
+       * @return - `true` if the cell owns the door.
+       */
+      virtual bool
+      owns(unsigned door, bool inverted, unsigned& slot) const noexcept = 0;
+
       /**
        * @brief - Interface method allowing to provide a human readable
        *          name for a door.
@@ -195,9 +407,33 @@ namespace maze {
     protected:
 
       /// @brief - Friend declaration of the generation function.
-      friend void kruksal::generate(Maze& m);
-      friend void prim::generate(Maze& m);
-      friend void depthfirst::generate(Maze& m);
+      template <typename Topology>
+      friend class kruksal::Stepper;
+      template <typename Topology>
+      friend void kruksal::generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context);
+      template <typename Topology>
+      friend class prim::Stepper;
+      template <typename Topology>
+      friend class depthfirst::Stepper;
+      template <typename Topology>
+      friend class wilson::Stepper;
+      template <typename Topology>
+      friend class aldousbroder::Stepper;
+      friend class eller::Stepper;
+      friend class binarytree::Stepper;
+      friend class sidewinder::Stepper;
+      template <typename Topology>
+      friend void boruvka::generate(Maze& m, std::uint64_t seed, ThreadPool& pool, Context* context);
+      template <typename Topology>
+      friend void tiles::generate(Maze& m, std::uint64_t seed, ThreadPool& pool, unsigned size, Context* context);
+      template <typename Topology>
+      friend void recursivedivision::generate(Maze& m, std::uint64_t seed, ThreadPool& pool, unsigned cutoff, Context* context);
+      template <typename Topology>
+      friend class recursivedivision::Stepper;
+      template <typename Topology>
+      friend class growingtree::Stepper;
+      template <typename Topology>
+      friend void braid::apply(Maze& m, std::uint64_t seed, ThreadPool& pool, float fraction, Context* context);
 
       /**
        * @brief - The width of the maze in cells.
@@ -220,11 +456,42 @@ namespace maze {
       unsigned m_cellSides;
 
       /**
-       * @brief - The cells for this maze.
+       * @brief - The number of walls owned by each cell (see the
+       *          `owns` method).
+       */
+      unsigned m_slots;
+
+      /**
+       * @brief - The number of bits used to store each row of one
+       *          slot of the walls. This is padded to a multiple of
+       *          64 bits so that rows start on a word boundary.
+       */
+      unsigned m_stride;
+
+      /**
+       * @brief - The state of each wall of the maze. A set bit means
+       *          that the wall is open. Each wall is stored once and
+       *          the state of the doors of a cell is derived from it.
+       *          The walls are laid out by slot, then by row and then
+       *          by column (see the `wall` method).
        */
-      std::vector<Cell> m_cells;
+      Bitset m_walls;
+
+      /**
+       * @brief - The neighbors of each cell. This is lazily built
+       *          the first time it is needed.
+       */
+      mutable Adjacency m_adjacency;
+
+      /**
+       * @brief - The policy used by the growing tree strategy to
+       *          pick the cell to expand.
+       */
+      growingtree::Policy m_policy;
   };
 
 }
 
+# include "Maze.hxx"
+
 #endif    /* MAZE_HH */
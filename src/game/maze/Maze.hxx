@@ -0,0 +1,79 @@
+#ifndef    MAZE_HXX
+# define   MAZE_HXX
+
+# include "Maze.hh"
+
+namespace maze {
+
+  inline
+  unsigned
+  Maze::linear(unsigned x, unsigned y) const noexcept {
+    return y * m_width + x;
+  }
+
+  inline
+  unsigned
+  Maze::slotIndex(unsigned x, unsigned y, unsigned slot) const noexcept {
+    return (slot * m_height + y) * m_stride + x;
+  }
+
+  template <typename Topology>
+  inline
+  unsigned
+  Maze::wall(unsigned x, unsigned y, unsigned door) const noexcept {
+    unsigned slot = 0u;
+    if (Topology::owns(door, Topology::inverted(x, y), slot)) {
+      return slotIndex(x, y, slot);
+    }
+
+    return wall<Topology>(x, y, door, Topology::neighbor(x, y, m_width, door));
+  }
+
+  template <typename Topology>
+  inline
+  unsigned
+  Maze::wall(unsigned x, unsigned y, unsigned door, unsigned neighbor) const noexcept {
+    bool inv = Topology::inverted(x, y);
+
+    // In case the cell does not own the door, the state
+    // of the wall is held by the cell on the other side.
+    unsigned slot = 0u;
+    if (!Topology::owns(door, inv, slot)) {
+      unsigned nx = neighbor % m_width;
+      unsigned ny = neighbor / m_width;
+
+      Topology::owns(Topology::opposite(door, inv), Topology::inverted(nx, ny), slot);
+
+      return slotIndex(nx, ny, slot);
+    }
+
+    return slotIndex(x, y, slot);
+  }
+
+  template <typename Topology>
+  inline
+  std::uint8_t
+  Maze::doors(unsigned x, unsigned y) const noexcept {
+    const unsigned* neighbors = adjacency()[linear(x, y)];
+
+    std::uint8_t mask = 0u;
+
+    for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+      // Doors leading outside of the maze are always closed.
+      if (neighbors[d] == Adjacency::BORDER) {
+        continue;
+      }
+
+      bool open = m_walls[wall<Topology>(x, y, d, neighbors[d])];
+
+      if (open) {
+        mask |= (1u << d);
+      }
+    }
+
+    return mask;
+  }
+
+}
+
+#endif    /* MAZE_HXX */
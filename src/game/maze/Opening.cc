@@ -1,6 +1,5 @@
 
 # include "Opening.hh"
-# include <cstdlib>
 
 namespace maze {
 
@@ -11,8 +10,8 @@ namespace maze {
     m_x(x),
     m_y(y),
 
-    m_doors(sides, true),
-    m_opened(sides),
+    m_sides(sides),
+    m_doors((1u << sides) - 1u),
 
     m_inverted(inverted)
   {}
@@ -34,43 +33,23 @@ namespace maze {
 
   void
   Opening::close(unsigned door) noexcept {
-    if (door < m_doors.size()) {
-      // Keep track of the number of opened doors.
-      if (m_doors[door]) {
-        --m_opened;
-      }
-
-      m_doors[door] = false;
+    if (door < m_sides) {
+      m_doors &= ~(1u << door);
     }
   }
 
   bool
   Opening::canBeOpened(unsigned door) const noexcept {
-    if (door >= m_doors.size()) {
+    if (door >= m_sides) {
       return false;
     }
 
-    return m_doors[door];
+    return (m_doors >> door) & 1u;
   }
 
   unsigned
-  Opening::breach(bool& boxed) const noexcept {
-    // In case there are no doors left to open, do
-    // nothing and return immediately.
-    boxed = (m_opened == 0u);
-    if (boxed) {
-      return 0u;
-    }
-
-    unsigned id = 0u;
-    bool valid = false;
-
-    while (!valid) {
-      id = std::rand() % m_doors.size();
-      valid = (m_doors[id] == true);
-    }
-
-    return id;
+  Opening::mask() const noexcept {
+    return m_doors;
   }
 
 }
@@ -1,8 +1,6 @@
 #ifndef    OPENING_HH
 # define   OPENING_HH
 
-# include <vector>
-
 namespace maze {
 
   class Opening {
@@ -63,17 +61,13 @@ namespace maze {
       canBeOpened(unsigned door) const noexcept;
 
       /**
-       * @brief - Pick a random door to open among the ones that
-       *          are not yet opened.
-       *          In case all the doors are obstructed, the output
-       *          value will be set to `true`.
-       * @param boxed - `true` in case all doors are not available
-       *                to be breached. In this case, ignore the
-       *                return value.
-       * @return - the index of the door to open.
+       * @brief - Return the doors that can be opened packed as a
+       *          bitmask: the bit at index `i` is set if the door
+       *          `i` can be opened.
+       * @return - the mask of doors that can be opened.
        */
       unsigned
-      breach(bool& boxed) const noexcept;
+      mask() const noexcept;
 
     private:
 
@@ -88,14 +82,16 @@ namespace maze {
       unsigned m_y;
 
       /**
-       * @brief - The status of each door of the opening.
+       * @brief - The number of doors of the opening.
        */
-      std::vector<bool> m_doors;
+      unsigned m_sides;
 
       /**
-       * @brief - The amount of doors that are opened.
+       * @brief - The status of each door of the opening packed
+       *          as a bitmask. The cells have at most six doors
+       *          so this is enough.
        */
-      unsigned m_opened;
+      unsigned m_doors;
 
       /**
        * @brief - Whether the opening is an inverted cell
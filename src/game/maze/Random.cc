@@ -0,0 +1,64 @@
+
+# include "Random.hh"
+# include <random>
+
+namespace maze {
+
+  Random::Random(std::uint64_t seed, unsigned stream) noexcept:
+    m_state()
+  {
+    this->seed(seed, stream);
+  }
+
+  void
+  Random::seed(std::uint64_t seed, unsigned stream) noexcept {
+    // Expand the seed with a splitmix64 generator as
+    // advised by the authors of the algorithm: this
+    // never yields an all zeros state.
+    for (unsigned id = 0u ; id < 4u ; ++id) {
+      seed += 0x9e3779b97f4a7c15ull;
+      m_state[id] = mix(seed);
+    }
+
+    for (unsigned id = 0u ; id < stream ; ++id) {
+      jump();
+    }
+  }
+
+  void
+  Random::jump() noexcept {
+    static const std::uint64_t JUMP[] = {
+      0x180ec6d33cfd0abaull,
+      0xd5a61266f0c9392cull,
+      0xa9582618e03fc9aaull,
+      0x39abdc4529b1661cull
+    };
+
+    std::uint64_t s[4] = {0u, 0u, 0u, 0u};
+
+    for (unsigned id = 0u ; id < 4u ; ++id) {
+      for (unsigned b = 0u ; b < 64u ; ++b) {
+        if ((JUMP[id] >> b) & 1u) {
+          for (unsigned w = 0u ; w < 4u ; ++w) {
+            s[w] ^= m_state[w];
+          }
+        }
+
+        next();
+      }
+    }
+
+    for (unsigned w = 0u ; w < 4u ; ++w) {
+      m_state[w] = s[w];
+    }
+  }
+
+  std::uint64_t
+  Random::entropy() {
+    std::random_device rd;
+
+    std::uint64_t seed = rd();
+    return (seed << 32u) ^ rd();
+  }
+
+}
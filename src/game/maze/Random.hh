@@ -0,0 +1,166 @@
+#ifndef    RANDOM_HH
+# define   RANDOM_HH
+
+# include <cstdint>
+# include <limits>
+
+namespace maze {
+
+  /// @brief - A pseudo random number generator used by all the
+  /// generation strategies. It implements the xoshiro256** from
+  /// here: https://prng.di.unimi.it/
+  /// The generator is fully determined by its seed: two of them
+  /// created with the same seed produce the same sequence. Each
+  /// generator is independent so that one can be used per thread.
+  class Random {
+    public:
+
+      /// @brief - The type of values produced by the generator. It
+      /// also allows the generator to be used with the algorithms
+      /// of the standard library.
+      using result_type = std::uint64_t;
+
+      /**
+       * @brief - Create a new generator from the input seed. The
+       *          stream allows to create several generators with
+       *          the same seed which produce sequences that do not
+       *          overlap: the stream `n` starts `n * 2^128` values
+       *          after the stream `0`. Creating a stream is linear
+       *          in its index so it should be kept small (typically
+       *          the index of a thread).
+       * @param seed - the seed of the generator.
+       * @param stream - the index of the stream to create.
+       */
+      explicit
+      Random(std::uint64_t seed = 0u, unsigned stream = 0u) noexcept;
+
+      /**
+       * @brief - Reset the generator as if it was just created with
+       *          the input seed and stream.
+       * @param seed - the seed of the generator.
+       * @param stream - the index of the stream to create.
+       */
+      void
+      seed(std::uint64_t seed, unsigned stream = 0u) noexcept;
+
+      /**
+       * @brief - Produce the next value of the sequence.
+       * @return - a random value uniformly distributed over the
+       *           whole range of 64 bits values.
+       */
+      std::uint64_t
+      next() noexcept;
+
+      /**
+       * @brief - Produce a random value in the range `[0; bound)`
+       *          without any bias. The bound should be positive.
+       *          The algorithm is taken from Lemire's "Fast Random
+       *          Integer Generation in an Interval".
+       * @param bound - the upper bound (excluded) of the value.
+       * @return - a random value smaller than the bound.
+       */
+      unsigned
+      bounded(unsigned bound) noexcept;
+
+      /**
+       * @brief - Produce a random value in the range `[0; 1)`.
+       * @return - a random floating point value.
+       */
+      double
+      uniform() noexcept;
+
+      /**
+       * @brief - Shuffle the elements in the input range so that
+       *          all permutations are equally likely.
+       * @param first - an iterator on the first element.
+       * @param last - an iterator past the last element.
+       */
+      template <typename Iterator>
+      void
+      shuffle(Iterator first, Iterator last) noexcept;
+
+      /**
+       * @brief - Advance the generator by `2^128` values. This is
+       *          used to create non overlapping streams.
+       */
+      void
+      jump() noexcept;
+
+      /**
+       * @brief - Used to allow the generator to be used with the
+       *          algorithms of the standard library.
+       * @return - the next value of the sequence.
+       */
+      result_type
+      operator()() noexcept;
+
+      static constexpr result_type
+      min() noexcept {
+        return std::numeric_limits<result_type>::min();
+      }
+
+      static constexpr result_type
+      max() noexcept {
+        return std::numeric_limits<result_type>::max();
+      }
+
+      /**
+       * @brief - Mix the bits of the input value to produce a well
+       *          distributed one. This is the finalizer of the
+       *          splitmix64 generator and can be used to derive a
+       *          seed or a hash from structured values.
+       * @param value - the value to mix.
+       * @return - the mixed value.
+       */
+      static
+      std::uint64_t
+      mix(std::uint64_t value) noexcept;
+
+      /**
+       * @brief - Combine a seed and a value (typically the index
+       *          of an element) into a new well distributed value.
+       * @param seed - the seed to combine.
+       * @param value - the value to combine with the seed.
+       * @return - the combined value.
+       */
+      static
+      std::uint64_t
+      mix(std::uint64_t seed, std::uint64_t value) noexcept;
+
+      /**
+       * @brief - Produce a seed from a non deterministic source.
+       *          This is meant to be used when the user does not
+       *          provide a seed explicitly.
+       * @return - a random seed.
+       */
+      static
+      std::uint64_t
+      entropy();
+
+    private:
+
+      /**
+       * @brief - Rotate the bits of the input value to the left.
+       * @param x - the value to rotate.
+       * @param k - the number of bits to rotate by, in `]0; 64[`.
+       * @return - the rotated value.
+       */
+      static
+      std::uint64_t
+      rotl(std::uint64_t x, unsigned k) noexcept;
+
+    private:
+
+      /**
+       * @brief - The internal state of the generator. It should
+       *          never be all zeros which is guaranteed by the
+       *          seeding procedure.
+       */
+      std::uint64_t m_state[4];
+  };
+
+}
+
+# include "Random.hxx"
+
+#endif    /* RANDOM_HH */
@@ -0,0 +1,95 @@
+#ifndef    RANDOM_HXX
+# define   RANDOM_HXX
+
+# include "Random.hh"
+# include <utility>
+
+namespace maze {
+
+  inline
+  std::uint64_t
+  Random::rotl(std::uint64_t x, unsigned k) noexcept {
+    return (x << k) | (x >> (64u - k));
+  }
+
+  inline
+  std::uint64_t
+  Random::next() noexcept {
+    std::uint64_t out = rotl(m_state[1] * 5u, 7u) * 9u;
+    std::uint64_t t = m_state[1] << 17u;
+
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+
+    m_state[2] ^= t;
+    m_state[3] = rotl(m_state[3], 45u);
+
+    return out;
+  }
+
+  inline
+  unsigned
+  Random::bounded(unsigned bound) noexcept {
+    // Multiply a 32 bits random value by the bound: the high
+    // part of the product is the result. Some of the values
+    // are over-represented: they are detected by the low part
+    // and rejected.
+    std::uint64_t m = (next() >> 32u) * bound;
+    std::uint32_t low = static_cast<std::uint32_t>(m);
+
+    if (low < bound) {
+      std::uint32_t threshold = static_cast<std::uint32_t>(-bound) % bound;
+      while (low < threshold) {
+        m = (next() >> 32u) * bound;
+        low = static_cast<std::uint32_t>(m);
+      }
+    }
+
+    return static_cast<unsigned>(m >> 32u);
+  }
+
+  inline
+  double
+  Random::uniform() noexcept {
+    // Use the 53 high bits as the mantissa of the value.
+    return (next() >> 11u) * 0x1.0p-53;
+  }
+
+  template <typename Iterator>
+  inline
+  void
+  Random::shuffle(Iterator first, Iterator last) noexcept {
+    // Fisher-Yates shuffle: each element is swapped with
+    // one of the elements not yet processed.
+    unsigned size = static_cast<unsigned>(last - first);
+
+    for (unsigned id = size ; id > 1u ; --id) {
+      std::swap(first[id - 1u], first[bounded(id)]);
+    }
+  }
+
+  inline
+  Random::result_type
+  Random::operator()() noexcept {
+    return next();
+  }
+
+  inline
+  std::uint64_t
+  Random::mix(std::uint64_t value) noexcept {
+    value = (value ^ (value >> 30u)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27u)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31u);
+  }
+
+  inline
+  std::uint64_t
+  Random::mix(std::uint64_t seed, std::uint64_t value) noexcept {
+    return mix(mix(seed + 0x9e3779b97f4a7c15ull) ^ value);
+  }
+
+}
+
+#endif    /* RANDOM_HXX */
@@ -0,0 +1,220 @@
+
+# include "RowGenerator.hh"
+# include <string>
+# include <algorithm>
+# include <core_utils/CoreException.hh>
+# include "Topology.hh"
+
+namespace maze {
+
+  RowGenerator::RowGenerator(unsigned width,
+                             unsigned height,
+                             unsigned sides,
+                             std::uint64_t seed,
+                             Workspace* workspace):
+    m_width(width),
+    m_height(height),
+    m_sides(sides),
+
+    // Each cell owns half of its doors (rounded up).
+    m_slots((m_sides + 1u) / 2u),
+    m_next(0u),
+
+    m_rng(seed),
+
+    m_ownWorkspace(workspace == nullptr ? std::make_unique<Workspace>() : nullptr),
+    m_workspace(workspace == nullptr ? *m_ownWorkspace : *workspace),
+
+    m_sets(m_workspace.regions(2u * m_width)),
+    m_walls(m_workspace.cells(m_slots * m_width)),
+
+    m_horizontal(m_workspace.allocate<Edge>(m_slots * m_width)),
+    m_horizontalCount(0u),
+    m_vertical(m_workspace.allocate<Edge>(m_slots * m_width)),
+    m_verticalCount(0u),
+    m_scratch(m_workspace.allocate<unsigned>(3u * m_width))
+  {
+    if (m_sides != topology::Triangle::SIDES &&
+        m_sides != topology::Square::SIDES &&
+        m_sides != topology::Hexagon::SIDES)
+    {
+      throw utils::CoreException(
+        "Failed to create row generator",
+        "eller",
+        "maze",
+        "Unsupported number of sides " + std::to_string(m_sides)
+      );
+    }
+  }
+
+  bool
+  RowGenerator::next() {
+    if (m_width == 0u || m_next >= m_height) {
+      return false;
+    }
+
+    topology::dispatch(m_sides,
+      [this](auto t) {
+        generate<decltype(t)>();
+      }
+    );
+
+    ++m_next;
+
+    return true;
+  }
+
+  template <typename Topology>
+  void
+  RowGenerator::generate() {
+    // The algorithm is taken from here:
+    // http://www.neocomputer.org/projects/eller.html
+    // The topologies only depend on the parity of the row:
+    // working on a virtual maze of at most two rows keeps
+    // the indices small whatever the height of the maze.
+    unsigned y = m_next % 2u;
+    bool last = (m_next + 1u == m_height);
+    unsigned h = y + (last ? 1u : 2u);
+
+    m_walls.clear();
+
+    // Gather the walls owned by the cells of the row: they
+    // either lead to the next cell of the row or to a cell
+    // of the next row. Cells never own walls leading to the
+    // previous row.
+    m_horizontalCount = 0u;
+    m_verticalCount = 0u;
+
+    for (unsigned x = 0u ; x < m_width ; ++x) {
+      bool inv = Topology::inverted(x, y);
+      unsigned closed = Topology::closed(x, y, m_width, h);
+
+      unsigned slot = 0u;
+      for (unsigned d = 0u ; d < Topology::SIDES ; ++d) {
+        if (((closed >> d) & 1u) || !Topology::owns(d, inv, slot)) {
+          continue;
+        }
+
+        Edge e{x, Topology::neighbor(x, y, m_width, d) - y * m_width, slot};
+        if (e.other < m_width) {
+          m_horizontal[m_horizontalCount] = e;
+          ++m_horizontalCount;
+        }
+        else {
+          m_vertical[m_verticalCount] = e;
+          ++m_verticalCount;
+        }
+      }
+    }
+
+    // The last row joins all the sets as there is no other
+    // way to connect them.
+    if (last) {
+      for (unsigned id = 0u ; id < m_horizontalCount ; ++id) {
+        join(m_horizontal[id]);
+      }
+
+      return;
+    }
+
+    // Randomly join adjacent cells of the row.
+    for (unsigned id = 0u ; id < m_horizontalCount ; ++id) {
+      if (m_rng.bounded(2u) == 0u) {
+        join(m_horizontal[id]);
+      }
+    }
+
+    // Each set needs to be connected to the next row. Some
+    // cells (typically triangles pointing down) do not have
+    // any wall leading to it: in case a set is only made of
+    // such cells, it is joined with one of its neighbors.
+    std::fill_n(m_scratch, 2u * m_width, 0u);
+
+    for (unsigned id = 0u ; id < m_verticalCount ; ++id) {
+      m_scratch[m_sets.find(m_vertical[id].cell)] = 1u;
+    }
+
+    for (unsigned id = 0u ; id < m_horizontalCount ; ++id) {
+      const Edge& e = m_horizontal[id];
+      unsigned lhs = m_scratch[m_sets.find(e.cell)];
+      unsigned rhs = m_scratch[m_sets.find(e.other)];
+
+      if ((lhs == 0u || rhs == 0u) && join(e)) {
+        m_scratch[m_sets.find(e.cell)] = lhs | rhs;
+      }
+    }
+
+    // Pick one of the walls leading to the next row for each
+    // set. As long as no such wall is opened, the sets are
+    // represented by a cell of the current row: the first
+    // half of the scratch counts the walls of each set and
+    // the second one keeps the one picked so far.
+    std::fill_n(m_scratch, 2u * m_width, 0u);
+
+    for (unsigned id = 0u ; id < m_verticalCount ; ++id) {
+      unsigned root = m_sets.find(m_vertical[id].cell);
+
+      ++m_scratch[root];
+      if (m_rng.bounded(m_scratch[root]) == 0u) {
+        m_scratch[m_width + root] = id;
+      }
+    }
+
+    for (unsigned x = 0u ; x < m_width ; ++x) {
+      if (m_sets.find(x) == x && m_scratch[x] == 0u) {
+        throw utils::CoreException(
+          "Failed to generate row " + std::to_string(m_next),
+          "eller",
+          "maze",
+          "Cell " + std::to_string(x) + " can't be connected to the next row"
+        );
+      }
+    }
+
+    for (unsigned x = 0u ; x < m_width ; ++x) {
+      if (m_scratch[x] > 0u) {
+        join(m_vertical[m_scratch[m_width + x]]);
+      }
+    }
+
+    // Randomly open more walls leading to the next row.
+    for (unsigned id = 0u ; id < m_verticalCount ; ++id) {
+      if (m_rng.bounded(2u) == 0u) {
+        join(m_vertical[id]);
+      }
+    }
+
+    // Carry the sets to the next row: each cell of the next
+    // row is attached to the first cell of its set in the
+    // row. Cells which are not connected to the current row
+    // start in their own set.
+    std::fill_n(m_scratch, 3u * m_width, m_width);
+
+    for (unsigned x = 0u ; x < m_width ; ++x) {
+      unsigned root = m_sets.find(m_width + x);
+      if (m_scratch[root] == m_width) {
+        m_scratch[root] = x;
+      }
+
+      m_scratch[2u * m_width + x] = m_scratch[root];
+    }
+
+    m_sets.reset(2u * m_width);
+
+    for (unsigned x = 0u ; x < m_width ; ++x) {
+      m_sets.merge(x, m_scratch[2u * m_width + x]);
+    }
+  }
+
+  bool
+  RowGenerator::join(const Edge& e) {
+    if (!m_sets.merge(e.cell, e.other)) {
+      return false;
+    }
+
+    m_walls.set(e.slot * m_width + e.cell);
+
+    return true;
+  }
+
+}
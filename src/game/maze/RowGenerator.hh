@@ -0,0 +1,230 @@
+#ifndef    ROW_GENERATOR_HH
+# define   ROW_GENERATOR_HH
+
+# include <memory>
+# include <cstdint>
+# include "Bitset.hh"
+# include "Random.hh"
+# include "UnionFind.hh"
+# include "Workspace.hh"
+
+namespace maze {
+
+  /// @brief - Generate a maze one row at a time with Eller's
+  /// algorithm, from the bottom row to the top one. Each row is
+  /// final as soon as it is produced: only the sets of the cells
+  /// of the current row are kept, so the memory used does not
+  /// depend on the height of the maze. This allows to generate
+  /// mazes which would not fit in memory and to send the rows
+  /// to a writer or a renderer as they are produced.
+  class RowGenerator {
+    public:
+
+      /**
+       * @brief - Create a new generator for a maze with the input
+       *          dimensions. The generation is deterministic: the
+       *          same seed always produces the same rows.
+       *          In case the number of sides is not supported an
+       *          error is raised.
+       * @param width - the width of the maze in cells.
+       * @param height - the height of the maze in cells.
+       * @param sides - the number of sides of the cells.
+       * @param seed - the seed of the random generator.
+       * @param workspace - the buffers to use for the rows or `null`
+       *                    to allocate new ones. The generator uses
+       *                    its set of bits, its disjoint-set structure
+       *                    and arrays of its arena: it should not be
+       *                    reset while the generator is used.
+       */
+      RowGenerator(unsigned width,
+                   unsigned height,
+                   unsigned sides,
+                   std::uint64_t seed,
+                   Workspace* workspace = nullptr);
+
+      /**
+       * @brief - The width of the maze in cells.
+       * @return - the width of the maze.
+       */
+      unsigned
+      width() const noexcept;
+
+      /**
+       * @brief - The height of the maze in cells.
+       * @return - the height of the maze.
+       */
+      unsigned
+      height() const noexcept;
+
+      /**
+       * @brief - The number of walls owned by each cell (see the
+       *          `owns` method of the topologies).
+       * @return - the number of slots of each cell.
+       */
+      unsigned
+      slots() const noexcept;
+
+      /**
+       * @brief - The index of the last row produced by the `next`
+       *          method. Meaningless before the first call.
+       * @return - the index of the current row.
+       */
+      unsigned
+      row() const noexcept;
+
+      /**
+       * @brief - Produce the next row of the maze. In case all the
+       *          rows have already been produced, nothing happens
+       *          and `false` is returned.
+       *          In case a row can't be connected to the next one
+       *          (for example a maze of triangles with a width of
+       *          1) an error is raised.
+       * @return - `true` if a new row was produced.
+       */
+      bool
+      next();
+
+      /**
+       * @brief - Whether the wall held in the specified slot by the
+       *          cell of the current row is open.
+       * @param x - the x coordinate of the cell in the row.
+       * @param slot - the slot of the wall.
+       * @return - `true` if the wall is open.
+       */
+      bool
+      open(unsigned x, unsigned slot) const noexcept;
+
+      /**
+       * @brief - The state of the walls owned by the cells of the
+       *          current row. The walls are laid out by slot and
+       *          then by column: the wall held in the slot `s` of
+       *          the cell `x` is at index `s * width + x`. A set
+       *          bit means that the wall is open.
+       * @return - the walls of the current row.
+       */
+      const Bitset&
+      walls() const noexcept;
+
+    private:
+
+      /// @brief - Convenience structure defining a wall owned by
+      /// a cell of the current row.
+      struct Edge {
+        // The x coordinate of the cell owning the wall.
+        unsigned cell;
+
+        // The index of the cell on the other side: cells of the
+        // current row are in `[0; width)` and the ones of the next
+        // row in `[width; 2 * width)`.
+        unsigned other;
+
+        // The slot of the wall in the owning cell.
+        unsigned slot;
+      };
+
+      /**
+       * @brief - Produce the next row for a known topology.
+       */
+      template <typename Topology>
+      void
+      generate();
+
+      /**
+       * @brief - Open the input wall in the current row and merge
+       *          the sets of the cells on each side. Nothing is
+       *          done if both cells already belong to the same set.
+       * @param e - the wall to open.
+       * @return - `true` if the wall was opened.
+       */
+      bool
+      join(const Edge& e);
+
+    private:
+
+      /**
+       * @brief - The width of the maze in cells.
+       */
+      unsigned m_width;
+
+      /**
+       * @brief - The height of the maze in cells.
+       */
+      unsigned m_height;
+
+      /**
+       * @brief - The number of sides of the cells.
+       */
+      unsigned m_sides;
+
+      /**
+       * @brief - The number of walls owned by each cell.
+       */
+      unsigned m_slots;
+
+      /**
+       * @brief - The index of the next row to produce.
+       */
+      unsigned m_next;
+
+      /**
+       * @brief - The random generator used for the generation.
+       */
+      Random m_rng;
+
+      /**
+       * @brief - The buffers allocated by the generator in case
+       *          none were provided.
+       */
+      std::unique_ptr<Workspace> m_ownWorkspace;
+
+      /**
+       * @brief - The buffers used by the generator.
+       */
+      Workspace& m_workspace;
+
+      /**
+       * @brief - The sets of the cells of the current row and of
+       *          the next one, indexed as in the `Edge` structure.
+       */
+      UnionFind& m_sets;
+
+      /**
+       * @brief - The walls of the current row (see `walls`).
+       */
+      Bitset& m_walls;
+
+      /**
+       * @brief - The walls between two cells of the current row,
+       *          with room for all the walls owned by the row.
+       */
+      Edge* m_horizontal;
+
+      /**
+       * @brief - The number of walls in `m_horizontal`.
+       */
+      unsigned m_horizontalCount;
+
+      /**
+       * @brief - The walls between the current row and the next,
+       *          with room for all the walls owned by the row.
+       */
+      Edge* m_vertical;
+
+      /**
+       * @brief - The number of walls in `m_vertical`.
+       */
+      unsigned m_verticalCount;
+
+      /**
+       * @brief - Scratch space indexed by the representative of a
+       *          set, reused for each row. It holds three values per
+       *          cell of the row.
+       */
+      unsigned* m_scratch;
+  };
+
+}
+
+# include "RowGenerator.hxx"
+
+#endif    /* ROW_GENERATOR_HH */
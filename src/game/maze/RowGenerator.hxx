@@ -0,0 +1,46 @@
+#ifndef    ROW_GENERATOR_HXX
+# define   ROW_GENERATOR_HXX
+
+# include "RowGenerator.hh"
+
+namespace maze {
+
+  inline
+  unsigned
+  RowGenerator::width() const noexcept {
+    return m_width;
+  }
+
+  inline
+  unsigned
+  RowGenerator::height() const noexcept {
+    return m_height;
+  }
+
+  inline
+  unsigned
+  RowGenerator::slots() const noexcept {
+    return m_slots;
+  }
+
+  inline
+  unsigned
+  RowGenerator::row() const noexcept {
+    return m_next - 1u;
+  }
+
+  inline
+  bool
+  RowGenerator::open(unsigned x, unsigned slot) const noexcept {
+    return m_walls[slot * m_width + x];
+  }
+
+  inline
+  const Bitset&
+  RowGenerator::walls() const noexcept {
+    return m_walls;
+  }
+
+}
+
+#endif    /* ROW_GENERATOR_HXX */
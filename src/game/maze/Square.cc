@@ -1,70 +1,43 @@
 
 # include "Square.hh"
+# include "Topology.hh"
 
 namespace maze {
 
   SquareMaze::SquareMaze(unsigned width, unsigned height, const Strategy& strategy):
-    Maze(width, height, strategy, 4u)
+    Maze(width, height, strategy, topology::Square::SIDES)
   {}
 
   bool
-  SquareMaze::inverted(unsigned /*x*/, unsigned /*y*/) const {
-    // A square is never inverted.
-    return false;
+  SquareMaze::inverted(unsigned x, unsigned y) const {
+    return topology::Square::inverted(x, y);
   }
 
   unsigned
-  SquareMaze::opposite(unsigned door, bool /*inverted*/) const noexcept {
-    // A drawing helps as well, but it's pretty simple.
-    return (door + 2u) % sides();
+  SquareMaze::opposite(unsigned door, bool inverted) const noexcept {
+    return topology::Square::opposite(door, inverted);
   }
 
   void
   SquareMaze::prepareOpening(Opening& o) const noexcept {
-    // Prevent opening of the left border of the maze.
-    if (o.x() == 0u) {
-      o.close(2u);
-    }
-    // Prevent opening of the right border of the maze.
-    if (o.x() == width() - 1u) {
-        o.close(0u);
-    }
-    // Prevent opening of the bottom border of the maze.
-    if (o.y() == 0u) {
-      o.close(1u);
-    }
-    // Prevent opening of the top border of the maze.
-    if (o.y() == height() - 1u) {
-      o.close(3u);
+    // Close the doors leading outside of the maze.
+    unsigned mask = topology::Square::closed(o.x(), o.y(), width(), height());
+
+    for (unsigned d = 0u ; d < sides() ; ++d) {
+      if ((mask >> d) & 1u) {
+        o.close(d);
+      }
     }
   }
 
   unsigned
   SquareMaze::idFromDoorAndCell(unsigned x, unsigned y, unsigned door) const {
-    unsigned id = linear(x, y);
-
-    if(door == 0) {
-      // Opening the right door, it always points to the
-      // cell right after the initial one.
-      ++id;
-    }
-    else if (door == 1u) {
-      // Opening the bottom door, it points to the cell
-      // one row before in the array.
-      id -= width();
-    }
-    else if (door == 2u) {
-      // Opening the left door, it always points to the
-      // cell right before the initial one.
-      --id;
-    }
-    else {
-      // Opening the top door, it points to the cell one
-      // row after in the array.
-      id += width();
-    }
+    return topology::Square::neighbor(x, y, width(), door);
+  }
 
-    return id;
+  bool
+  SquareMaze::owns(unsigned door, bool inverted, unsigned& slot) const noexcept {
+    return topology::Square::owns(door, inverted, slot);
   }
 
   std::string
@@ -0,0 +1,259 @@
+
+# include "ThreadPool.hh"
+# include <algorithm>
+
+namespace maze {
+
+  ThreadPool::ThreadPool(unsigned threads):
+    m_threads(),
+
+    m_locker(),
+    m_start(),
+    m_done(),
+
+    m_run(0u),
+    m_active(0u),
+    m_stop(false),
+
+    m_task(nullptr),
+    m_count(0u),
+    m_next(0u),
+    m_error(),
+
+    m_queues(),
+    m_pending(0u),
+
+    m_idleLocker(),
+    m_idle(),
+    m_spawned(0u)
+  {
+    if (threads == 0u) {
+      threads = std::thread::hardware_concurrency();
+    }
+    threads = std::max(threads, 1u);
+
+    m_queues.reset(new Queue[threads]);
+
+    // The calling thread also runs tasks.
+    for (unsigned id = 1u ; id < threads ; ++id) {
+      m_threads.emplace_back(&ThreadPool::loop, this, id);
+    }
+  }
+
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> guard(m_locker);
+      m_stop = true;
+    }
+
+    m_start.notify_all();
+
+    for (unsigned id = 0u ; id < m_threads.size() ; ++id) {
+      m_threads[id].join();
+    }
+  }
+
+  void
+  ThreadPool::run(unsigned count, const Task& task) {
+    if (count == 0u) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(m_locker);
+
+      m_task = &task;
+      m_count = count;
+      m_next.store(0u);
+      m_error = nullptr;
+
+      m_active = static_cast<unsigned>(m_threads.size());
+      ++m_run;
+    }
+
+    m_start.notify_all();
+
+    work(0u);
+
+    // Wait for the other threads to be done: they only
+    // leave the run once no task is left.
+    std::unique_lock<std::mutex> lock(m_locker);
+    m_done.wait(lock, [this]() { return m_active == 0u; });
+
+    m_task = nullptr;
+
+    if (m_error != nullptr) {
+      std::exception_ptr error = m_error;
+      m_error = nullptr;
+
+      std::rethrow_exception(error);
+    }
+  }
+
+  void
+  ThreadPool::loop(unsigned id) {
+    unsigned run = 0u;
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(m_locker);
+        m_start.wait(lock, [this, run]() { return m_stop || m_run != run; });
+
+        if (m_stop) {
+          return;
+        }
+
+        run = m_run;
+      }
+
+      work(id);
+
+      {
+        std::lock_guard<std::mutex> guard(m_locker);
+        --m_active;
+      }
+
+      m_done.notify_one();
+    }
+  }
+
+  void
+  ThreadPool::work(unsigned id) {
+    unsigned task = m_next.fetch_add(1u);
+
+    while (task < m_count) {
+      try {
+        (*m_task)(task, id);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> guard(m_locker);
+        if (m_error == nullptr) {
+          m_error = std::current_exception();
+        }
+      }
+
+      task = m_next.fetch_add(1u);
+    }
+  }
+
+  void
+  ThreadPool::execute(const Job& job) {
+    m_pending.store(1u);
+    m_spawned.store(0u);
+    m_queues[0u].jobs.push_back(job);
+
+    // Each thread runs jobs until none are left: as jobs are
+    // only spawned by running jobs, no new job can appear once
+    // the pending count reaches zero.
+    run(size(),
+      [this](unsigned /*task*/, unsigned thread) {
+        std::exception_ptr error;
+        Job job;
+        unsigned misses = 0u;
+
+        while (m_pending.load() > 0u) {
+          // The count of spawned jobs is read before looking for
+          // one so that a job spawned in between wakes the thread.
+          unsigned spawned = m_spawned.load();
+
+          if (!pick(thread, job)) {
+            // Yield a few times as jobs are usually spawned at a
+            // fast pace, then wait for a new one to be available.
+            if (++misses < IDLE_SPINS) {
+              std::this_thread::yield();
+              continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_idleLocker);
+            m_idle.wait(lock,
+              [this, spawned]() {
+                return m_pending.load() == 0u || m_spawned.load() != spawned;
+              }
+            );
+
+            misses = 0u;
+            continue;
+          }
+
+          misses = 0u;
+
+          try {
+            job(thread);
+          }
+          catch (...) {
+            if (error == nullptr) {
+              error = std::current_exception();
+            }
+          }
+
+          job = nullptr;
+
+          // Wake up the waiting threads when the last job is done
+          // so that they leave the execution.
+          if (m_pending.fetch_sub(1u) == 1u) {
+            std::lock_guard<std::mutex> guard(m_idleLocker);
+            m_idle.notify_all();
+          }
+        }
+
+        if (error != nullptr) {
+          std::rethrow_exception(error);
+        }
+      }
+    );
+  }
+
+  void
+  ThreadPool::spawn(unsigned thread, Job job) {
+    m_pending.fetch_add(1u);
+
+    {
+      Queue& q = m_queues[thread];
+      std::lock_guard<std::mutex> guard(q.locker);
+      q.jobs.push_back(std::move(job));
+    }
+
+    // The count is updated with the lock held so that a thread
+    // about to wait does not miss the notification.
+    {
+      std::lock_guard<std::mutex> guard(m_idleLocker);
+      m_spawned.fetch_add(1u);
+    }
+
+    m_idle.notify_one();
+  }
+
+  bool
+  ThreadPool::pick(unsigned thread, Job& job) {
+    // Favor the most recent jobs of the thread: they are
+    // likely to work on data still in its caches.
+    {
+      Queue& q = m_queues[thread];
+      std::lock_guard<std::mutex> guard(q.locker);
+
+      if (!q.jobs.empty()) {
+        job = std::move(q.jobs.back());
+        q.jobs.pop_back();
+        return true;
+      }
+    }
+
+    // Steal the oldest job of another thread: it usually
+    // represents the largest amount of work.
+    unsigned count = size();
+
+    for (unsigned id = 1u ; id < count ; ++id) {
+      Queue& q = m_queues[(thread + id) % count];
+      std::lock_guard<std::mutex> guard(q.locker);
+
+      if (!q.jobs.empty()) {
+        job = std::move(q.jobs.front());
+        q.jobs.pop_front();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+}
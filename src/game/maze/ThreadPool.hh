@@ -0,0 +1,238 @@
+#ifndef    THREAD_POOL_HH
+# define   THREAD_POOL_HH
+
+# include <deque>
+# include <mutex>
+# include <atomic>
+# include <memory>
+# include <thread>
+# include <vector>
+# include <exception>
+# include <functional>
+# include <condition_variable>
+
+namespace maze {
+
+  /// @brief - A pool of threads used to run the parallel parts of
+  /// the generation. The work is expressed either as a number of
+  /// tasks identified by their index (see `run`) or as jobs which
+  /// can spawn other jobs (see `execute`). In both cases the
+  /// threads of the pool and the calling thread share the work
+  /// until none is left. The threads are created once and wait
+  /// for work in between two runs.
+  class ThreadPool {
+    public:
+
+      /// @brief - The number of times a thread without jobs looks
+      /// for one before waiting for a job to be spawned.
+      static constexpr unsigned IDLE_SPINS = 16u;
+
+      /// @brief - Convenience define for the work executed by the
+      /// pool: it receives the index of the task to run and the
+      /// index of the thread running it, in `[0; size())`.
+      using Task = std::function<void(unsigned, unsigned)>;
+
+      /// @brief - Convenience define for a job executed by the pool:
+      /// it receives the index of the thread running it, which
+      /// should be used to spawn new jobs.
+      using Job = std::function<void(unsigned)>;
+
+      /**
+       * @brief - Create a new pool with the specified number of
+       *          threads, including the calling thread. A value of
+       *          `0` uses the number of cores of the machine.
+       * @param threads - the number of threads of the pool.
+       */
+      explicit
+      ThreadPool(unsigned threads = 0u);
+
+      /**
+       * @brief - Wait for the threads of the pool to terminate.
+       */
+      ~ThreadPool();
+
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      /**
+       * @brief - The number of threads running the tasks, including
+       *          the calling thread.
+       * @return - the number of threads of the pool.
+       */
+      unsigned
+      size() const noexcept;
+
+      /**
+       * @brief - Run the tasks with indices in `[0; count)` on the
+       *          threads of the pool and wait for all of them to be
+       *          done. The order in which the tasks are executed is
+       *          not defined. In case a task raises an exception,
+       *          the remaining tasks are still run and the first
+       *          exception is raised again once they are done.
+       *          This method should not be called from a task.
+       * @param count - the number of tasks to run.
+       * @param task - the work to execute for each task.
+       */
+      void
+      run(unsigned count, const Task& task);
+
+      /**
+       * @brief - Execute the input job on the threads of the pool and
+       *          wait for it and all the jobs it spawned (directly or
+       *          not) to be done. Each thread keeps its own queue of
+       *          jobs: it runs the jobs it spawned first, the most
+       *          recent first, and steals the oldest jobs of the
+       *          other threads when its queue is empty.
+       *          Exceptions are handled as in the `run` method. This
+       *          method should not be called from a task or a job.
+       * @param job - the first job to execute.
+       */
+      void
+      execute(const Job& job);
+
+      /**
+       * @brief - Spawn a new job from a job executed by the pool: it
+       *          will be run by one of the threads before `execute`
+       *          returns.
+       * @param thread - the index of the thread spawning the job, as
+       *                 received by the job.
+       * @param job - the job to spawn.
+       */
+      void
+      spawn(unsigned thread, Job job);
+
+    private:
+
+      /// @brief - The jobs spawned by a thread: the owner pops the
+      /// most recent ones and the other threads steal the oldest.
+      struct Queue {
+        // Protects the jobs of the queue.
+        std::mutex locker;
+
+        // The jobs waiting to be executed.
+        std::deque<Job> jobs;
+      };
+
+      /**
+       * @brief - Pick a job from the queue of the thread, or from the
+       *          queue of another thread in case it is empty.
+       * @param thread - the index of the thread looking for a job.
+       * @param job - output argument receiving the job.
+       * @return - `true` if a job was found.
+       */
+      bool
+      pick(unsigned thread, Job& job);
+
+    private:
+
+      /**
+       * @brief - The main loop of the threads of the pool.
+       * @param id - the index of the thread.
+       */
+      void
+      loop(unsigned id);
+
+      /**
+       * @brief - Pick and run the tasks of the current run until
+       *          none are left.
+       * @param id - the index of the thread running the tasks.
+       */
+      void
+      work(unsigned id);
+
+    private:
+
+      /**
+       * @brief - The threads of the pool (the calling thread is not
+       *          part of it).
+       */
+      std::vector<std::thread> m_threads;
+
+      /**
+       * @brief - Protects the data describing the current run.
+       */
+      std::mutex m_locker;
+
+      /**
+       * @brief - Notified when a new run starts or when the pool is
+       *          destroyed.
+       */
+      std::condition_variable m_start;
+
+      /**
+       * @brief - Notified when a thread is done with the current run.
+       */
+      std::condition_variable m_done;
+
+      /**
+       * @brief - The index of the current run, used by the threads
+       *          to detect that a new one started.
+       */
+      unsigned m_run;
+
+      /**
+       * @brief - The number of threads of the pool still working on
+       *          the current run.
+       */
+      unsigned m_active;
+
+      /**
+       * @brief - Whether the threads should terminate.
+       */
+      bool m_stop;
+
+      /**
+       * @brief - The work of the current run.
+       */
+      const Task* m_task;
+
+      /**
+       * @brief - The number of tasks of the current run.
+       */
+      unsigned m_count;
+
+      /**
+       * @brief - The index of the next task to run.
+       */
+      std::atomic<unsigned> m_next;
+
+      /**
+       * @brief - The first exception raised by a task of the run.
+       */
+      std::exception_ptr m_error;
+
+      /**
+       * @brief - The queues of jobs of each thread, including the
+       *          calling thread.
+       */
+      std::unique_ptr<Queue[]> m_queues;
+
+      /**
+       * @brief - The number of jobs spawned and not yet done.
+       */
+      std::atomic<unsigned> m_pending;
+
+      /**
+       * @brief - Protects the wait of the threads without jobs.
+       */
+      std::mutex m_idleLocker;
+
+      /**
+       * @brief - Notified when a job is spawned or when the last
+       *          pending job is done.
+       */
+      std::condition_variable m_idle;
+
+      /**
+       * @brief - The number of jobs spawned since the beginning of
+       *          the execution, used by the threads without jobs to
+       *          detect that a new one is available.
+       */
+      std::atomic<unsigned> m_spawned;
+  };
+
+}
+
+# include "ThreadPool.hxx"
+
+#endif    /* THREAD_POOL_HH */
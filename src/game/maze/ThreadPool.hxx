@@ -0,0 +1,16 @@
+#ifndef    THREAD_POOL_HXX
+# define   THREAD_POOL_HXX
+
+# include "ThreadPool.hh"
+
+namespace maze {
+
+  inline
+  unsigned
+  ThreadPool::size() const noexcept {
+    return static_cast<unsigned>(m_threads.size()) + 1u;
+  }
+
+}
+
+#endif    /* THREAD_POOL_HXX */
@@ -0,0 +1,145 @@
+#ifndef    TOPOLOGY_HH
+# define   TOPOLOGY_HH
+
+namespace maze {
+  namespace topology {
+
+    /// @brief - Compile-time description of the layout of the cells
+    /// of a maze. Each topology provides the same set of static
+    /// methods which mirror the hooks of the `Maze` interface: this
+    /// allows the generators to be instantiated for each topology
+    /// so that the neighbor arithmetic can be inlined in the hot
+    /// loops instead of going through virtual calls.
+    /// The methods assume that the coordinates and doors are valid.
+
+    struct Triangle {
+      /// @brief - The number of doors of each cell.
+      static constexpr unsigned SIDES = 3u;
+
+      /// @brief - The number of walls owned by each cell.
+      static constexpr unsigned SLOTS = 2u;
+
+      /**
+       * @brief - Whether the cell at the specified coordinates is
+       *          inverted.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @return - `true` if the cell is inverted.
+       */
+      static bool
+      inverted(unsigned x, unsigned y) noexcept;
+
+      /**
+       * @brief - The index of the door leading back to the input
+       *          cell from the cell on the other side of the door.
+       * @param door - the door to traverse.
+       * @param inverted - whether the cell is inverted.
+       * @return - the opposite door.
+       */
+      static unsigned
+      opposite(unsigned door, bool inverted) noexcept;
+
+      /**
+       * @brief - The doors of the cell leading outside of the maze
+       *          packed as a bitmask.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @param width - the width of the maze.
+       * @param height - the height of the maze.
+       * @return - the mask of doors that can't be opened.
+       */
+      static unsigned
+      closed(unsigned x, unsigned y, unsigned width, unsigned height) noexcept;
+
+      /**
+       * @brief - The linear index of the cell reached through the
+       *          door of the input cell. The door should not lead
+       *          outside of the maze.
+       * @param x - the x coordinate of the cell.
+       * @param y - the y coordinate of the cell.
+       * @param width - the width of the maze.
+       * @param door - the door to traverse.
+       * @return - the linear index of the neighboring cell.
+       */
+      static unsigned
+      neighbor(unsigned x, unsigned y, unsigned width, unsigned door) noexcept;
+
+      /**
+       * @brief - Whether the cell owns the door (see `Maze::owns`).
+       * @param door - the door of the cell.
+       * @param inverted - whether the cell is inverted.
+       * @param slot - output argument defining the slot of the wall.
+       * @return - `true` if the cell owns the door.
+       */
+      static bool
+      owns(unsigned door, bool inverted, unsigned& slot) noexcept;
+    };
+
+    struct Square {
+      /// @brief - The number of doors of each cell.
+      static constexpr unsigned SIDES = 4u;
+
+      /// @brief - The number of walls owned by each cell.
+      static constexpr unsigned SLOTS = 2u;
+
+      static bool
+      inverted(unsigned x, unsigned y) noexcept;
+
+      static unsigned
+      opposite(unsigned door, bool inverted) noexcept;
+
+      static unsigned
+      closed(unsigned x, unsigned y, unsigned width, unsigned height) noexcept;
+
+      static unsigned
+      neighbor(unsigned x, unsigned y, unsigned width, unsigned door) noexcept;
+
+      static bool
+      owns(unsigned door, bool inverted, unsigned& slot) noexcept;
+    };
+
+    struct Hexagon {
+      /// @brief - The number of doors of each cell.
+      static constexpr unsigned SIDES = 6u;
+
+      /// @brief - The number of walls owned by each cell.
+      static constexpr unsigned SLOTS = 3u;
+
+      static bool
+      inverted(unsigned x, unsigned y) noexcept;
+
+      static unsigned
+      opposite(unsigned door, bool inverted) noexcept;
+
+      static unsigned
+      closed(unsigned x, unsigned y, unsigned width, unsigned height) noexcept;
+
+      static unsigned
+      neighbor(unsigned x, unsigned y, unsigned width, unsigned door) noexcept;
+
+      static bool
+      owns(unsigned door, bool inverted, unsigned& slot) noexcept;
+    };
+
+    /**
+     * @brief - Call the input function with an instance of the
+     *          topology matching the number of sides. This is the
+     *          single place where the runtime number of sides is
+     *          turned into a compile-time topology.
+     * @param sides - the number of sides of the cells.
+     * @param func - the function to call: it should accept any of
+     *               the topologies as argument.
+     * @return - `false` in case the number of sides does not match
+     *           any topology, in which case the function is not
+     *           called.
+     */
+    template <typename Func>
+    bool
+    dispatch(unsigned sides, Func&& func);
+
+  }
+}
+
+# include "Topology.hxx"
+
+#endif    /* TOPOLOGY_HH */
@@ -0,0 +1,297 @@
+#ifndef    TOPOLOGY_HXX
+# define   TOPOLOGY_HXX
+
+# include "Topology.hh"
+
+namespace maze {
+  namespace topology {
+
+    inline
+    bool
+    Triangle::inverted(unsigned x, unsigned y) noexcept {
+      // In a triangle, we start the first row by an inverted
+      // triangle, and then pursue with a regular one. The row
+      // on top is then starting with a regular triangle, and
+      // then an inverted one. And so on.
+      return (x % 2u) == (y % 2u);
+    }
+
+    inline
+    unsigned
+    Triangle::opposite(unsigned door, bool inverted) noexcept {
+      // The opposite move is different in case we have an
+      // inverted cell or not.
+      // Drawing the situation helps here.
+      if (inverted) {
+        return (door + SIDES - 1u) % SIDES;
+      }
+
+      return (door + 1u) % SIDES;
+    }
+
+    inline
+    unsigned
+    Triangle::closed(unsigned x, unsigned y, unsigned width, unsigned height) noexcept {
+      unsigned mask = 0u;
+      bool inv = inverted(x, y);
+
+      // Prevent opening of the left border of the maze.
+      if (x == 0u) {
+        mask |= (y % 2u == 0u ? 1u << 1u : 1u << 2u);
+      }
+      // Prevent opening of the right border of the maze.
+      if (x == width - 1u) {
+        mask |= 1u << 0u;
+      }
+      // Prevent opening of the bottom border of the maze.
+      // Note that only the non inverted triangles will be
+      // affected by an opening that can't be performed.
+      if (y == 0u && !inv) {
+        mask |= 1u << 1u;
+      }
+      // Prevent opening of the top border of the maze.
+      // Note that only the inverted triangles will be
+      // affected by an opening that can't be performed.
+      if (y == height - 1u && inv) {
+        mask |= 1u << 2u;
+      }
+
+      return mask;
+    }
+
+    inline
+    unsigned
+    Triangle::neighbor(unsigned x, unsigned y, unsigned width, unsigned door) noexcept {
+      unsigned id = y * width + x;
+
+      if (door == 0u) {
+        // Opening the right door, it always points to the
+        // cell right after the initial one.
+        return id + 1u;
+      }
+
+      // Door 1 leads to the left for inverted triangles and
+      // to the bottom otherwise, while door 2 leads to the
+      // top for inverted triangles and to the left otherwise.
+      bool inv = inverted(x, y);
+      if (door == 1u) {
+        return inv ? id - 1u : id - width;
+      }
+
+      return inv ? id + width : id - 1u;
+    }
+
+    inline
+    bool
+    Triangle::owns(unsigned door, bool inverted, unsigned& slot) noexcept {
+      // A triangle always owns its right door. Inverted ones
+      // also own their top door: the regular triangle above
+      // them reaches it through its bottom door.
+      if (door == 0u) {
+        slot = 0u;
+        return true;
+      }
+      if (inverted && door == 2u) {
+        slot = 1u;
+        return true;
+      }
+
+      return false;
+    }
+
+    inline
+    bool
+    Square::inverted(unsigned /*x*/, unsigned /*y*/) noexcept {
+      // A square is never inverted.
+      return false;
+    }
+
+    inline
+    unsigned
+    Square::opposite(unsigned door, bool /*inverted*/) noexcept {
+      // A drawing helps as well, but it's pretty simple.
+      return (door + 2u) % SIDES;
+    }
+
+    inline
+    unsigned
+    Square::closed(unsigned x, unsigned y, unsigned width, unsigned height) noexcept {
+      unsigned mask = 0u;
+
+      // Left, right, bottom and top borders of the maze.
+      if (x == 0u) {
+        mask |= 1u << 2u;
+      }
+      if (x == width - 1u) {
+        mask |= 1u << 0u;
+      }
+      if (y == 0u) {
+        mask |= 1u << 1u;
+      }
+      if (y == height - 1u) {
+        mask |= 1u << 3u;
+      }
+
+      return mask;
+    }
+
+    inline
+    unsigned
+    Square::neighbor(unsigned x, unsigned y, unsigned width, unsigned door) noexcept {
+      unsigned id = y * width + x;
+
+      switch (door) {
+        case 0u:
+          // Right door, the cell right after the initial one.
+          return id + 1u;
+        case 1u:
+          // Bottom door, the cell one row before.
+          return id - width;
+        case 2u:
+          // Left door, the cell right before the initial one.
+          return id - 1u;
+        default:
+          // Top door, the cell one row after.
+          return id + width;
+      }
+    }
+
+    inline
+    bool
+    Square::owns(unsigned door, bool /*inverted*/, unsigned& slot) noexcept {
+      // A square owns its right and top doors.
+      switch (door) {
+        case 0u:
+          slot = 0u;
+          return true;
+        case 3u:
+          slot = 1u;
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    inline
+    bool
+    Hexagon::inverted(unsigned /*x*/, unsigned /*y*/) noexcept {
+      // A hexagon is never inverted.
+      return false;
+    }
+
+    inline
+    unsigned
+    Hexagon::opposite(unsigned door, bool /*inverted*/) noexcept {
+      // The opposite side is reached by adding 3 to the
+      // door's index.
+      return (door + 3u) % SIDES;
+    }
+
+    inline
+    unsigned
+    Hexagon::closed(unsigned x, unsigned y, unsigned width, unsigned height) noexcept {
+      unsigned mask = 0u;
+
+      // Prevent opening of the left border of the maze.
+      if (x == 0u) {
+        mask |= (1u << 2u) | (1u << 3u);
+      }
+      // Prevent opening of the right border of the maze.
+      if (x == width - 1u) {
+        mask |= (1u << 0u) | (1u << 5u);
+      }
+      // Prevent opening of the bottom border of the maze.
+      // Hexagons with odd x coordinates will be slightly
+      // lower which means more of their doors will have
+      // to be closed.
+      if (y == 0u) {
+        mask |= 1u << 1u;
+        if (x % 2u == 0u) {
+          mask |= (1u << 0u) | (1u << 2u);
+        }
+      }
+      // Prevent opening of the top border of the maze.
+      // Hexagons with even x coordinates will be slightly
+      // lower which means more of their doors will have
+      // to be closed.
+      if (y == height - 1u) {
+        mask |= 1u << 4u;
+        if (x % 2u == 1u) {
+          mask |= (1u << 3u) | (1u << 5u);
+        }
+      }
+
+      return mask;
+    }
+
+    inline
+    unsigned
+    Hexagon::neighbor(unsigned x, unsigned y, unsigned width, unsigned door) noexcept {
+      unsigned id = y * width + x;
+      bool odd = (x % 2u == 1u);
+
+      switch (door) {
+        case 0u:
+          // Bottom right door: the cell immediately after
+          // for odd hexagons and almost one row before for
+          // even ones.
+          return odd ? id + 1u : id - (width - 1u);
+        case 1u:
+          // Bottom door, the cell one row before.
+          return id - width;
+        case 2u:
+          // Bottom left door: the cell immediately before
+          // for odd hexagons and almost one row before for
+          // even ones.
+          return odd ? id - 1u : id - (width + 1u);
+        case 3u:
+          // Top left door: the cell immediately before for
+          // even hexagons and almost one row after for odd
+          // ones.
+          return odd ? id + (width - 1u) : id - 1u;
+        case 4u:
+          // Top door, the cell one row after.
+          return id + width;
+        default:
+          // Top right door: the cell immediately after for
+          // even hexagons and almost one row after for odd
+          // ones.
+          return odd ? id + (width + 1u) : id + 1u;
+      }
+    }
+
+    inline
+    bool
+    Hexagon::owns(unsigned door, bool /*inverted*/, unsigned& slot) noexcept {
+      // An hexagon owns its top left, top and top right doors.
+      if (door < 3u) {
+        return false;
+      }
+
+      slot = door - 3u;
+      return true;
+    }
+
+    template <typename Func>
+    inline
+    bool
+    dispatch(unsigned sides, Func&& func) {
+      switch (sides) {
+        case Triangle::SIDES:
+          func(Triangle());
+          return true;
+        case Square::SIDES:
+          func(Square());
+          return true;
+        case Hexagon::SIDES:
+          func(Hexagon());
+          return true;
+        default:
+          return false;
+      }
+    }
+
+  }
+}
+
+#endif    /* TOPOLOGY_HXX */
@@ -0,0 +1,25 @@
+
+# include "UnionFind.hh"
+# include <numeric>
+
+namespace maze {
+
+  UnionFind::UnionFind(unsigned size):
+    m_parents(),
+    m_ranks(),
+    m_sets(0u)
+  {
+    reset(size);
+  }
+
+  void
+  UnionFind::reset(unsigned size) {
+    m_parents.resize(size);
+    std::iota(m_parents.begin(), m_parents.end(), 0u);
+
+    m_ranks.assign(size, 0u);
+
+    m_sets = size;
+  }
+
+}
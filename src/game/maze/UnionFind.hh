@@ -0,0 +1,98 @@
+#ifndef    UNION_FIND_HH
+# define   UNION_FIND_HH
+
+# include <vector>
+# include <utility>
+
+namespace maze {
+
+  class UnionFind {
+    public:
+
+      /**
+       * @brief - Create a new disjoint-set structure where each of
+       *          the elements lives in its own set.
+       * @param size - the number of elements in the structure.
+       */
+      explicit
+      UnionFind(unsigned size = 0u);
+
+      /**
+       * @brief - The number of elements tracked by this structure.
+       * @return - the number of elements.
+       */
+      unsigned
+      size() const noexcept;
+
+      /**
+       * @brief - The number of disjoint sets currently defined.
+       * @return - the number of sets.
+       */
+      unsigned
+      sets() const noexcept;
+
+      /**
+       * @brief - Reset the structure so that it contains the input
+       *          number of elements, each one in its own set. The
+       *          memory already allocated is reused if possible.
+       * @param size - the number of elements in the structure.
+       */
+      void
+      reset(unsigned size);
+
+      /**
+       * @brief - Return the representative of the set containing
+       *          the input element. The path to the representative
+       *          is compressed along the way.
+       *          The element is assumed to be valid.
+       * @param id - the element to find.
+       * @return - the representative of the set of the element.
+       */
+      unsigned
+      find(unsigned id) noexcept;
+
+      /**
+       * @brief - Whether the two elements belong to the same set.
+       * @param lhs - the first element.
+       * @param rhs - the second element.
+       * @return - `true` if both elements are in the same set.
+       */
+      bool
+      connected(unsigned lhs, unsigned rhs) noexcept;
+
+      /**
+       * @brief - Merge the sets containing both elements. We use a
+       *          union by rank to keep the trees shallow.
+       * @param lhs - the first element.
+       * @param rhs - the second element.
+       * @return - `true` in case the sets were merged and `false`
+       *           if both elements already belonged to the same set.
+       */
+      bool
+      merge(unsigned lhs, unsigned rhs) noexcept;
+
+    private:
+
+      /**
+       * @brief - The parent of each element. A representative is
+       *          its own parent.
+       */
+      std::vector<unsigned> m_parents;
+
+      /**
+       * @brief - An upper bound of the height of the tree rooted at
+       *          each element. Only meaningful for representatives.
+       */
+      std::vector<unsigned char> m_ranks;
+
+      /**
+       * @brief - The number of disjoint sets.
+       */
+      unsigned m_sets;
+  };
+
+}
+
+# include "UnionFind.hxx"
+
+#endif    /* UNION_FIND_HH */
@@ -0,0 +1,73 @@
+#ifndef    UNION_FIND_HXX
+# define   UNION_FIND_HXX
+
+# include "UnionFind.hh"
+
+namespace maze {
+
+  inline
+  unsigned
+  UnionFind::size() const noexcept {
+    return m_parents.size();
+  }
+
+  inline
+  unsigned
+  UnionFind::sets() const noexcept {
+    return m_sets;
+  }
+
+  inline
+  unsigned
+  UnionFind::find(unsigned id) noexcept {
+    // Find the representative of the set.
+    unsigned root = id;
+    while (m_parents[root] != root) {
+      root = m_parents[root];
+    }
+
+    // Compress the path so that all the elements traversed
+    // directly point to the representative.
+    while (m_parents[id] != root) {
+      unsigned next = m_parents[id];
+      m_parents[id] = root;
+      id = next;
+    }
+
+    return root;
+  }
+
+  inline
+  bool
+  UnionFind::connected(unsigned lhs, unsigned rhs) noexcept {
+    return find(lhs) == find(rhs);
+  }
+
+  inline
+  bool
+  UnionFind::merge(unsigned lhs, unsigned rhs) noexcept {
+    lhs = find(lhs);
+    rhs = find(rhs);
+
+    if (lhs == rhs) {
+      return false;
+    }
+
+    // Attach the shallowest tree below the deepest one.
+    if (m_ranks[lhs] < m_ranks[rhs]) {
+      std::swap(lhs, rhs);
+    }
+
+    m_parents[rhs] = lhs;
+    if (m_ranks[lhs] == m_ranks[rhs]) {
+      ++m_ranks[lhs];
+    }
+
+    --m_sets;
+
+    return true;
+  }
+
+}
+
+#endif    /* UNION_FIND_HXX */
@@ -0,0 +1,63 @@
+
+# include "Workspace.hh"
+
+namespace maze {
+
+  Workspace::Workspace() noexcept:
+    m_arena(),
+    m_capacity(0u),
+    m_used(0u),
+    m_demand(0u),
+    m_overflow(),
+
+    m_cells(),
+    m_regions(0u)
+  {}
+
+  void
+  Workspace::reset() {
+    // Merge the blocks needed by the previous generation in
+    // the arena so that the next one fits in it.
+    if (m_demand > m_capacity) {
+      m_arena.reset(new unsigned char[m_demand]);
+      m_capacity = m_demand;
+    }
+
+    m_overflow.clear();
+    m_used = 0u;
+    m_demand = 0u;
+  }
+
+  Bitset&
+  Workspace::cells(unsigned size) {
+    m_cells.reset(size);
+    return m_cells;
+  }
+
+  UnionFind&
+  Workspace::regions(unsigned size) {
+    m_regions.reset(size);
+    return m_regions;
+  }
+
+  void*
+  Workspace::allocate(std::size_t bytes, std::size_t alignment) {
+    // Track where the block would be in an arena large enough
+    // for all the blocks handed out since the last reset.
+    m_demand = (m_demand + alignment - 1u) / alignment * alignment + bytes;
+
+    std::size_t offset = (m_used + alignment - 1u) / alignment * alignment;
+    if (offset + bytes <= m_capacity) {
+      m_used = offset + bytes;
+      return m_arena.get() + offset;
+    }
+
+    // The arena is full: the memory allocated with `new` is
+    // suitably aligned for any trivial type.
+    m_used = m_capacity;
+    m_overflow.emplace_back(new unsigned char[bytes]);
+
+    return m_overflow.back().get();
+  }
+
+}
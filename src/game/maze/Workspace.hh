@@ -0,0 +1,131 @@
+#ifndef    WORKSPACE_HH
+# define   WORKSPACE_HH
+
+# include <memory>
+# include <vector>
+# include <cstddef>
+# include "Bitset.hh"
+# include "UnionFind.hh"
+
+namespace maze {
+
+  /// @brief - The memory used by the generation of a maze: it can
+  /// be kept between generations so that generating mazes of the
+  /// same size again does not allocate anything. It contains a
+  /// monotonic arena handing out arrays of trivial types, which
+  /// are all released at once when a new generation starts, and
+  /// typed buffers for the structures used by most algorithms.
+  /// The arena only grows when a generation needs more memory
+  /// than the largest one before it.
+  class Workspace {
+    public:
+
+      /**
+       * @brief - Create a new workspace: no memory is allocated
+       *          until it is used.
+       */
+      Workspace() noexcept;
+
+      /**
+       * @brief - Prepare the workspace for a new generation: all the
+       *          arrays handed out by the arena are released. In case
+       *          the arena was too small for the previous generation,
+       *          it is reallocated with the size it would have needed.
+       */
+      void
+      reset();
+
+      /**
+       * @brief - The number of bytes available in the arena.
+       * @return - the capacity of the arena.
+       */
+      std::size_t
+      capacity() const noexcept;
+
+      /**
+       * @brief - Hand out an array from the arena. The elements are
+       *          not initialized. The array is valid until the next
+       *          call to `reset`.
+       * @param count - the number of elements of the array.
+       * @return - the first element of the array.
+       */
+      template <typename Type>
+      Type*
+      allocate(unsigned count);
+
+      /**
+       * @brief - A set of bits, one per cell of the maze, all of them
+       *          being cleared.
+       * @param size - the number of cells of the maze.
+       * @return - the set of bits.
+       */
+      Bitset&
+      cells(unsigned size);
+
+      /**
+       * @brief - A disjoint-set structure where each cell of the maze
+       *          lives in its own set.
+       * @param size - the number of cells of the maze.
+       * @return - the disjoint-set structure.
+       */
+      UnionFind&
+      regions(unsigned size);
+
+    private:
+
+      /**
+       * @brief - Hand out a block of memory from the arena. In case
+       *          it is too small, a dedicated block is allocated
+       *          until the next reset.
+       * @param bytes - the size of the block.
+       * @param alignment - the alignment of the block.
+       * @return - the block of memory.
+       */
+      void*
+      allocate(std::size_t bytes, std::size_t alignment);
+
+    private:
+
+      /**
+       * @brief - The memory of the arena.
+       */
+      std::unique_ptr<unsigned char[]> m_arena;
+
+      /**
+       * @brief - The size of the arena in bytes.
+       */
+      std::size_t m_capacity;
+
+      /**
+       * @brief - The number of bytes of the arena handed out since
+       *          the last reset.
+       */
+      std::size_t m_used;
+
+      /**
+       * @brief - The number of bytes requested since the last reset,
+       *          including the ones which did not fit in the arena.
+       */
+      std::size_t m_demand;
+
+      /**
+       * @brief - The blocks allocated because the arena was full.
+       */
+      std::vector<std::unique_ptr<unsigned char[]>> m_overflow;
+
+      /**
+       * @brief - The set of bits over the cells.
+       */
+      Bitset m_cells;
+
+      /**
+       * @brief - The disjoint-set structure over the cells.
+       */
+      UnionFind m_regions;
+  };
+
+}
+
+# include "Workspace.hxx"
+
+#endif    /* WORKSPACE_HH */
@@ -0,0 +1,31 @@
+#ifndef    WORKSPACE_HXX
+# define   WORKSPACE_HXX
+
+# include "Workspace.hh"
+# include <type_traits>
+
+namespace maze {
+
+  inline
+  std::size_t
+  Workspace::capacity() const noexcept {
+    return m_capacity;
+  }
+
+  template <typename Type>
+  inline
+  Type*
+  Workspace::allocate(unsigned count) {
+    // Arrays are never destroyed: they are dropped at once when
+    // the arena is reset.
+    static_assert(std::is_trivially_destructible<Type>::value, "Arena arrays should be trivially destructible");
+
+    Type* data = static_cast<Type*>(allocate(count * sizeof(Type), alignof(Type)));
+    std::uninitialized_default_construct_n(data, count);
+
+    return data;
+  }
+
+}
+
+#endif    /* WORKSPACE_HXX */